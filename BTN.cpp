@@ -47,3 +47,9 @@ bool BTN::IsDown()
   // non-debounced, instantaneous reading
   return m_iPin && digitalRead(m_iPin) == CLOSED_STATE;
 }
+
+bool BTN::IsClosed()
+{
+  // debounced, true while the button is held down. As of the last CheckButtonPress()
+  return m_iPin && m_iPrevState == CLOSED_STATE;
+}
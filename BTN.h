@@ -6,6 +6,7 @@ class BTN
     void Init(int Pin);
     bool CheckButtonPress();
     bool IsDown();
+    bool IsClosed();
     
   private:
     byte m_iPin = 0;
@@ -5,6 +5,7 @@
 #include "Ship.h"
 #include "Pins.h"
 #include "BTN.h"
+#include "Input.h"
 #include "RTC.h"
 #include "Text.h"
 #include "View.h"
@@ -93,29 +94,6 @@ void Init()
 }
 
 
-bool touchDown(int& x, int& y, bool& held)
-{
-  // True if the screen has been touched. held is true if > 2s
-  // "debounced"
-  int x1, y1;
-  held = false;
-  if (LCD_GET_TOUCH(x1, y1))
-  {
-    delay(10);
-    if (LCD_GET_TOUCH(x, y)) // still touched?
-    {
-      if (abs(x - x1) < 5 && abs(y - y1) < 5) // same place?
-      {
-        unsigned long downTimeMS = millis();
-        while ((held = LCD_GET_TOUCH(x1, y1)) && ((millis() - downTimeMS) < 2000))
-          ;
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
 bool getTouch(int& x, int& y)
 {
   // True if the screen has been touched.
@@ -505,29 +483,29 @@ void ConfigurationMenu()
 
 void Loop()
 {
-  // check for input, touches or buttons
-  int x, y;
-  bool held;
-  if (btn1Set.CheckButtonPress())
+  // act on this loop's input events, touches or buttons. See input::Poll()
+  if (input::btnSet == input::Press)
   {
     ConfigurationMenu();
   }
-  else if (btn2Adj.CheckButtonPress() && data.m_bShowLoadScreen)
+  else if (input::btnAdj == input::Press && data.m_bShowLoadScreen)
   {
     // next ship
     incrementEnum(data.m_ShipType, ship::Adder, ship::LAST_SHIP, true); // exclusive of last ship
     view::LoadShip(false, true);
     Save();
   }
-  else if (touchDown(x, y, held))
+  else if (input::touch == input::Hold || (input::touch == input::Release && !input::touchHeld))
   {
+    // a long press acts straight away, a tap on release
+    int x = input::touchX, y = input::touchY;
     int textX, eliteY, loadY;
     text::CharReader charReader;
     view::GetTextLine(0, textX, eliteY, charReader);
     eliteY += TEXT_SIZE;
     view::GetTextLine(1, textX, loadY, charReader);
 
-    if (held)
+    if (input::touch == input::Hold)
     {
       if (x > SCREEN_OFFSET_X && x < (SCREEN_OFFSET_X + SCREEN_WIDTH) && y > eliteY && y < loadY)
         view::ManualMode(x, y);
@@ -14,6 +14,7 @@ namespace config
     
     // Not stored in EEPROM:
     const unsigned long minimumFramePeriodMS = 0; // vs, for example 100ms for evened-out 10Hz minimum
+    const unsigned long targetFramePeriodMS = 0;  // vs, for example 100ms to shed detail from slow frames to hold ~10Hz (see View.cpp)
   };
   
   void Init();
@@ -18,6 +18,29 @@ void fillRect(int x, int y, int w, int h)
   LCD_FILL_COLOUR(LCD_BEGIN_FILL(x, y, w, h), config::data.m_bAcornElectron ? RGB(0xFF, 0xFF, 0xFF) : loader::palette[2]);
 }
 
+#ifdef ENABLE_RADAR_MARKER
+// where the radar marker is, -1 for none
+int markerY = -1;
+
+void UpdateRadar(int currentScale, int maxScale)
+{
+  // Move the ship marker, the image is put back under the old one, note that the centre of the radar screen is slightly offset left
+  int y = maxScale ? 10 + currentScale * 17 / maxScale : -1;
+  if (y == markerY)
+    return;
+  if (markerY != -1)
+  {
+    // the marker's rows of the dials image, they start a row above the marker's origin (see fillRect())
+    if (config::data.m_bAcornElectron)
+      loader::DrawBitImagePart(electronDials, SCREEN_HEIGHT - DIALS_HEIGHT, false, 123, markerY + 1, 3, 3);
+    else
+      loader::DrawBitImagePart(beebDials, SCREEN_HEIGHT - DIALS_HEIGHT, true, 123, markerY + 1, 3, 3);
+  }
+  if (y != -1)
+    fillRect(123, y, 3, 3);
+  markerY = y;
+}
+#else
 void UpdateRadar(int currentScale, int maxScale)
 {
   // Redraw the centre strip with a ship marker, note that the centre of the radar screen is slightly offset left
@@ -30,10 +53,14 @@ void UpdateRadar(int currentScale, int maxScale)
     fillRect(123, 10 + currentScale * 17 / maxScale, 3, 3);
   }
 }
+#endif
 
 void Draw(bool updateDials)
 {
   // Load the lower part of the screen, the dials and 3D view
+#ifdef ENABLE_RADAR_MARKER
+  markerY = -1;
+#endif
   if (config::data.m_bAcornElectron)
     loader::DrawMonoBitImage(electronDials, SCREEN_HEIGHT - DIALS_HEIGHT, DIALS_HEIGHT);
   else
@@ -5,6 +5,7 @@
 #include "Config.h"
 #include "View.h"
 #include "Elite.h"
+#include "Timer.h"
 
 namespace elite {
 
@@ -22,9 +23,42 @@ static const char commands[] PROGMEM =
  TEXT_MSTR("ELITE")
 ;
 
+bool running = false;  // the startup's done and the view is up
+
+void Started()
+{
+  // the loader's done
+  view::Init();
+  running = true;
+}
+
+#ifdef ENABLE_COMMAND
+// the blinking cursor at the end of the commands
+int cursorX, cursorY;
+int blinkMS;
+bool cursorOn;
+
+void Blink()
+{
+  // a blink of the cursor, then the next, a timer task. Clears the screen and loads a period after the last blink
+  const int periodMS = 250;
+  if (blinkMS <= 0)
+  {
+    LCD_FILL_BYTE(LCD_BEGIN_FILL(0, 0, LCD_WIDTH, LCD_HEIGHT), 0x00);
+    loader::Init(Started);
+    return;
+  }
+  char cursorStr[2] = { cursorOn?'_':' ', 0 };
+  text::Draw(cursorX, cursorY, cursorStr, text::StdCharReader);
+  cursorOn = !cursorOn;
+  blinkMS -= periodMS;
+  timer::After(periodMS, Blink);
+}
+#endif
+
 void Commands()
 {
-  // animate "typing" at the command prompt
+  // animate "typing" at the command prompt, the cursor blinks for a while (see Blink()) then loads
 #ifdef ENABLE_COMMAND
   int lineN = 0;
   int textRow = 0;
@@ -44,19 +78,13 @@ void Commands()
   }
   // blink the cursor at the end
   textRow--;
-  int delayMS = 5000;
-  const int blinkMS = 250;
-  bool cursorOn = true;
-  char cursorStr[2] = "_";
-  while (delayMS > 0)
-  {
-    text::Draw(TEXT_SIZE*strLen, TEXT_SIZE + TEXT_SIZE*textRow, cursorStr, text::StdCharReader);
-    cursorOn = !cursorOn;
-    cursorStr[0] = cursorOn?'_':' ';
-    delay(blinkMS);
-    delayMS -= blinkMS;
-  }
-  LCD_FILL_BYTE(LCD_BEGIN_FILL(0, 0, LCD_WIDTH, LCD_HEIGHT), 0x00);
+  cursorX = TEXT_SIZE*strLen;
+  cursorY = TEXT_SIZE + TEXT_SIZE*textRow;
+  blinkMS = 5000;
+  cursorOn = true;
+  Blink();
+#else
+  loader::Init(Started);
 #endif  
 }
 
@@ -66,6 +94,11 @@ void Init()
   elite::Start();
 }
 
+bool Running()
+{
+  return running;
+}
+
 void Loop()
 {
   view::Loop();
@@ -73,15 +106,14 @@ void Loop()
 
 void Start()
 {
-  // run the startup; commands, credits
+  // run the startup; commands, credits. Timed, it's done when Running()
+  running = false;
 #if defined(RTC_I2C_ADDRESS) && !defined(DEBUG)
   // seed the PRNG from time: hr, min, sec & day
   rtc.ReadTime();
-  randomSeed(*(reinterpret_cast<unsigned long*>(&rtc.m_Hour24)));
+  randomSeed(*(reinterpret_cast<uint32_t*>(&rtc.m_Hour24)));
 #endif  
   LCD_FILL_BYTE(LCD_BEGIN_FILL(0, 0, LCD_WIDTH, LCD_HEIGHT), 0x00);
   Commands();
-  loader::Init();
-  view::Init();
 }
 }
@@ -6,7 +6,9 @@
 // Initialise/define a window/fill it with colour.
 // Done with macros, LCD_BEGIN_FILL, LCD_FILL_COLOUR etc
 //#define LCD_LARGE
-#ifdef LCD_LARGE
+#ifdef LCD_HOST
+#include "Elite_Host.h"   // workstation build, see host/Makefile
+#elif defined(LCD_LARGE)
 #include "Elite_Large.h"
 #else
 #include "Elite_Small.h"
@@ -29,8 +31,16 @@
 #define ENABLE_COMMAND          // Show CHAIN command screen
 #define ENABLE_CREDITS          // Show Saturn screen
 #define ENABLE_APPROACH         // Show ship approach animation
+#define ENABLE_RADAR_MARKER     // Approach only moves the radar marker, not the whole centre strip of the dials
 #define ENABLE_RANDOM_ROTATION  // Randomize pitch/roll rates
+#define ENABLE_SHIP_LOD         // Distant ships drop their detail lines, by the blueprint visibility, as in Elite (see View.cpp)
+//#define ENABLE_TIMED_ANIMATION  // Tumble & approach at a rate set by millis(), not one step per frame (see View.cpp)
 #define ENABLE_SPARSE_WIDE      // Full width single sparse render
+//#define ENABLE_SPARSE_FENWICK   // Faster sparse row index, costs ~340 bytes RAM (see Sparse.cpp)
+//#define ENABLE_SPARSE_SLACK     // Sparse pool has slack per band of rows, less shuffling (see Sparse.cpp)
+//#define ENABLE_SPARSE_DIRTY     // Only repaint the rows that changed, costs 2 bytes RAM per row per pass (see Sparse.cpp)
+#define ENABLE_ROTATION_MATRIX  // Per-frame 16-bit rotation matrix vs 64-bit trig per vertex (see View.cpp)
+//#define ENABLE_TEXT_CACHE       // Titles are rasterized once, not every frame, costs ~440 bytes RAM (see Text.cpp)
 #define ENABLE_STD_CLOCK_DIGITS // Clock ship has generous digits
 #define ENABLE_STATUS_SCREEN    // Status text screen as alternative to ship
 #define ENABLE_GREEN_PALETTE    // Red, Green & Yellow dials vs Red, White & Cyan
@@ -38,6 +48,7 @@
 
 // Debugging, Serial, stats etc
 //#define DEBUG_STACK_CHECK          // Check that there's enough stack. Reported in Title
+//#define ENABLE_PROFILE             // Time the stages of a frame, dumped to Serial, independent of DEBUG. Costs ~450 bytes RAM (see Profile.h)
 //#define DEBUG
 #ifdef DEBUG
 // Dump variable to serial
@@ -57,4 +68,5 @@ namespace elite
   void Init();
   void Loop();
   void Start();
+  bool Running();
 };
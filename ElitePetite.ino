@@ -5,12 +5,15 @@
 #include "RTC.h"
 #include "Pins.h"
 #include "BTN.h"
+#include "Input.h"
+#include "Timer.h"
 #include "Text.h"
 #include "Sparse.h"
 #include "Ship.h"
 #include "Loader.h"
 #include "Config.h"
 #include "Elite.h"
+#include "Profile.h"
 
 
 /*
@@ -141,11 +144,15 @@ void StackCheck()
 #define StackCheck()
 #endif
 
+void Frame();
+
 void setup()
 {
 #ifdef DEBUG
   Serial.begin(38400);
   Serial.println("ElitePetite");
+#elif defined(ENABLE_PROFILE)
+  Serial.begin(38400);
 #endif  
   rtc.Setup();
 #if defined(PIN_BTN_SET) && defined(PIN_BTN_ADJ)
@@ -154,6 +161,7 @@ void setup()
 #endif  
   LCD_INIT();
   elite::Init();
+  timer::After(0, Frame);
 }
 
 #ifdef DEBUG
@@ -161,29 +169,47 @@ void setup()
 unsigned long sumMS = 0;
 extern unsigned long sumLinesMS;
 extern unsigned long sumPaintMS;
+extern unsigned long sumTransformUS;
 int count = 0;
 #endif
 
-void loop()
+void Frame()
 {
-  StackPaint();
-  config::Loop();
+  // a frame of the ship (or the status screen), a timer task. Comes round again after minimumFramePeriodMS, input is polled meanwhile
+  timer::After(config::data.minimumFramePeriodMS, Frame);
+  if (!elite::Running())
+    return;
+#ifdef DEBUG
   unsigned long nowMS = millis();
+#endif
   elite::Loop();
-  unsigned long durationMS = millis() - nowMS;
 #ifdef DEBUG
-  sumMS += durationMS;
+  sumMS += millis() - nowMS;
   count++;
   if (count == 2000)
   {
     Serial.println(sumMS / count);
     Serial.println(sumLinesMS / count);
     Serial.println(sumPaintMS / count);
+    DBG(sumTransformUS / count);
     // Cobra: ~85ms, 47ms lines, 38ms paint (without approach/radar) / 94,57,38 (FULL) 
     DBG(sparse::highWater); // Cobra:430 / 760 (FULL). Fur-de-lance ~ 460/780
+    DBG(sparse::movedBytes / count);
   }
 #endif  
-  if (durationMS < config::data.minimumFramePeriodMS)
-    delay(config::data.minimumFramePeriodMS - durationMS);
+#ifdef ENABLE_PROFILE
+  profile::Frame();
+#endif
+}
+
+void loop()
+{
+  StackPaint();
+  PROFILE_START(InputPoll);
+  input::Poll();
+  PROFILE_STOP(InputPoll);
+  if (elite::Running())
+    config::Loop();
+  timer::Run();   // the startup, frames etc.
   StackCheck();
 }
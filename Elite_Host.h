@@ -0,0 +1,42 @@
+#pragma once
+// Host version, a workstation build that renders into an in-memory frame buffer (see host/FrameBuffer.h)
+// Used for profiling and regression testing the rendering, every simulated WR strobe is counted
+#include "FrameBuffer.h"
+// The LCD interface
+// Initialise
+#define LCD_INIT() fb.init();
+// Define a window to fill with pixels at (_x,_y) width _w, height _h
+// Returns the number of pixels to fill (unsigned long)
+#define LCD_BEGIN_FILL(_x,_y,_w,_h) fb.beginFill(_x,_y,_w,_h)
+// Sends _sizeUL (unsigned long) pixels of the 16-bit colour
+#define LCD_FILL_COLOUR(_sizeUL, _colorWord) fb.fillColour(_sizeUL, _colorWord)
+// Sends _sizeUL (unsigned long) pixels of the 8-bit colour.
+// The byte is duplicated, 0xFF and 0x00 really only make sense. Slightly faster than above.
+#define LCD_FILL_BYTE(_sizeUL, _colorByte) fb.fillByte(_sizeUL, _colorByte)
+// Sends a single white pixel
+#define LCD_ONE_WHITE() fb.OneWhite()
+// Sends a single black pixel
+#define LCD_ONE_BLACK() fb.OneBlack()
+// True if there is a touch. Returns position in (int) _x, _y
+#define LCD_GET_TOUCH(_x, _y) fb.getTouch(_x, _y)
+
+// make an RGB word
+#define RGB(_r, _g, _b) (word)((_b & 0x00F8) >> 3) | ((_g & 0x00FC) << 3) | ((_r & 0x00F8) << 8)
+
+#ifdef LCD_LARGE
+// Mimic Elite_Large.h
+#define LCD_WIDTH  480
+#define LCD_HEIGHT 320
+
+#define SCREEN_WIDTH 256
+#define SCREEN_HEIGHT 248
+#else
+// Mimic Elite_Small.h
+#define LCD_WIDTH  320
+#define LCD_HEIGHT 240
+
+#define SCREEN_WIDTH 256
+#define SCREEN_HEIGHT 240 // vs 248
+#endif
+#define SCREEN_OFFSET_X ((LCD_WIDTH - SCREEN_WIDTH)/2)
+#define SCREEN_OFFSET_Y ((LCD_HEIGHT - SCREEN_HEIGHT)/2)
@@ -0,0 +1,141 @@
+#include <Arduino.h>
+#include "Elite.h"
+#include "BTN.h"
+#include "Input.h"
+
+// Touch & button events, see Input.h
+
+namespace input {
+Event touch = None;
+Event btnSet = None;
+Event btnAdj = None;
+int touchX = 0, touchY = 0;
+bool touchHeld = false;
+
+#define SETTLE_MS 10    // a touch has to stay put this long to count
+#define HOLD_MS   2000  // a Press held this long is a Hold
+#define SLOP_PX   5     // a touch moved this far from the Press is a Drag
+#define HOLD_SLOP_PX 20 // ...but can still Hold if it's not been further than this (resistive touch jitters)
+
+// touch: Up -> Settling -> Down -> Dragging, any of them -> Up when released
+enum Phase { Up, Settling, Down, Dragging };
+byte touchPhase = Up;
+int downX, downY;
+unsigned long touchPhaseMS = 0;
+bool touchStrayed = false;  // been beyond HOLD_SLOP_PX since the Press, so no Hold
+
+struct Button
+{
+  bool down;
+  bool held;
+  unsigned long downMS;
+};
+Button buttons[2];
+
+bool Near(int x, int y, int slop = SLOP_PX)
+{
+  // within the slop of where the touch went down
+  return abs(x - downX) < slop && abs(y - downY) < slop;
+}
+
+Event PollTouch()
+{
+  int x = 0, y = 0;
+  unsigned long nowMS = millis();
+  if (!LCD_GET_TOUCH(x, y))
+  {
+    byte phase = touchPhase;
+    touchPhase = Up;
+    if (phase == Down || phase == Dragging)
+    {
+      touchX = downX;
+      touchY = downY;
+      return Release;
+    }
+    return None;
+  }
+
+  if (touchPhase == Up)
+  {
+    // first contact, see if it settles
+    downX = x;
+    downY = y;
+    touchPhaseMS = nowMS;
+    touchPhase = Settling;
+  }
+  else if (touchPhase == Settling)
+  {
+    if (nowMS - touchPhaseMS >= SETTLE_MS)
+    {
+      if (Near(x, y))
+      {
+        downX = touchX = x;
+        downY = touchY = y;
+        touchHeld = false;
+        touchStrayed = false;
+        touchPhaseMS = nowMS;
+        touchPhase = Down;
+        return Press;
+      }
+      // skidded, settle from here
+      downX = x;
+      downY = y;
+      touchPhaseMS = nowMS;
+    }
+  }
+  else
+  {
+    // Down or Dragging
+    if (!Near(x, y, HOLD_SLOP_PX))
+      touchStrayed = true;
+    if (!touchHeld && !touchStrayed && nowMS - touchPhaseMS >= HOLD_MS)
+    {
+      touchX = downX;
+      touchY = downY;
+      touchHeld = true;
+      return Hold;
+    }
+    if ((touchPhase == Down) ? !Near(x, y) : (x != touchX || y != touchY))
+    {
+      touchX = x;
+      touchY = y;
+      touchPhase = Dragging;
+      return Drag;
+    }
+  }
+  return None;
+}
+
+Event PollButton(BTN& btn, Button& state)
+{
+  // BTN does the debouncing
+  unsigned long nowMS = millis();
+  if (btn.CheckButtonPress())
+  {
+    state.down = true;
+    state.held = false;
+    state.downMS = nowMS;
+    return Press;
+  }
+  if (!state.down)
+    return None;
+  if (!btn.IsClosed())
+  {
+    state.down = false;
+    return Release;
+  }
+  if (!state.held && nowMS - state.downMS >= HOLD_MS)
+  {
+    state.held = true;
+    return Hold;
+  }
+  return None;
+}
+
+void Poll()
+{
+  touch = PollTouch();
+  btnSet = PollButton(btn1Set, buttons[0]);
+  btnAdj = PollButton(btn2Adj, buttons[1]);
+}
+}
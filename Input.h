@@ -0,0 +1,23 @@
+#pragma once
+
+// Polled input, the touch screen and the Set & Adj buttons
+// Poll() advances a state machine per source, once per loop(), and never waits, so the ship keeps
+// tumbling while a finger or a button is down.  Each source then has one event until the next Poll()
+namespace input
+{
+  enum Event
+  {
+    None,
+    Press,    // down (debounced)
+    Hold,     // still down 2s after the Press, once per press.  Not sent once dragged 20px away
+    Drag,     // touch only, moved away from the Press or along since the last Drag
+    Release   // up after a Press
+  };
+  void Poll();
+
+  extern Event touch;
+  extern Event btnSet;
+  extern Event btnAdj;
+  extern int touchX, touchY;  // where pressed, or where dragged to for Drag
+  extern bool touchHeld;      // a Hold was sent for this press, so a Release isn't a tap
+};
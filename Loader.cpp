@@ -6,6 +6,7 @@
 #include "Dials.h"
 #include "Loader.h"
 #include "Config.h"
+#include "Timer.h"
 
 namespace loader {
 // forward decls
@@ -13,53 +14,51 @@ extern const word owlIcon[];
 void DrawBackground(int x, int y, int w, int h);
 void DrawMonoBitImage(const byte* pData, int y, int height, int insetBlocks);
 
-void Init()
+void (*loaded)();  // Init()'s done
+
+void ShowScreen()
 {
-  // Animate the credits then prepare the screen
+  // the final step, prepare the screen
+  DrawBackground();
+  DrawSpaceArea();
+  loaded();
+}
+
 #ifdef ENABLE_CREDITS
-  credits::Draw();
-  delay(4000);
+#ifdef ENABLE_RAM_OVERFLOW  
+void Overflow()
+{
+  // overflow into screen RAM with some arbitrary data
+  DrawMonoBitImage((const byte*)ship::NameMultiStr_PGM, 0, 8, 0);
+  timer::After(500, ShowScreen);
+}
+#endif  
+
+void ShowDials()
+{
   dials::Draw(false);
-  delay(1000);
 #ifdef ENABLE_RAM_OVERFLOW  
   if (config::data.m_bAcornElectron)
   {
-    // overflow into screen RAM with some arbitrary data
-    DrawMonoBitImage((const byte*)ship::NameMultiStr_PGM, 0, 8, 0);
-    delay(500);
+    timer::After(1000, Overflow);
+    return;
   }
 #endif  
-#else
-  dials::Draw(false);
-#endif
-  DrawBackground();
-  DrawSpaceArea();
+  timer::After(1000, ShowScreen);
 }
+#endif
 
-void DrawMonoBitImage(const byte* pData, int y, int height, int insetBlocks)
+void Init(void (*done)())
 {
-  // Load 1-bit-per-pixel screen-memory data
-  // insetBlocks skips that many cols of 8 pixels from the left and right sides
-  int widthBlocks = SCREEN_WIDTH / 8 - 2 * insetBlocks;
-  LCD_BEGIN_FILL(SCREEN_OFFSET_X + 8 * insetBlocks, SCREEN_OFFSET_Y + y, widthBlocks * 8, height);
-  for (int strip = 0; strip < height / 8; strip++)
-  {
-    for (int row = 0; row < 8; row++)
-    {
-      const byte* pByte = pData + row + insetBlocks * 8;
-      for (int col = 0; col < widthBlocks; col++)
-      {
-        byte Byte = pgm_read_byte_near(pByte);
-        if (Byte)
-          for (int bit = 0; bit < 8; bit++)
-            LCD_FILL_BYTE(1, (Byte & (0x80 >> bit)) ? 0xFF : 0x00);
-        else
-          LCD_FILL_BYTE(8, 0x00);
-        pByte += 8;
-      }
-    }
-    pData += 8 * 32;
-  }
+  // Animate the credits then prepare the screen, timed steps (see Timer.h) ending with done()
+  loaded = done;
+#ifdef ENABLE_CREDITS
+  credits::Draw();
+  timer::After(4000, ShowDials);
+#else
+  dials::Draw(false);
+  ShowScreen();
+#endif
 }
 
 #ifdef ENABLE_GREEN_PALETTE
@@ -68,34 +67,78 @@ const word palette[4] = {RGB(0x00, 0x00, 0x00), RGB(0xFF, 0x00, 0x00), RGB(0xFF,
 const word palette[4] = {RGB(0x00, 0x00, 0x00), RGB(0xFF, 0x00, 0x00), RGB(0xFF, 0xFF, 0xFF), RGB(0x00, 0xFF, 0xFF)}; // black, red, white, cyan (escape capsule)
 #endif
 
-void DrawColourBitImage(const byte* pData, int y, int height, int insetBlocks)
+// Bit images are painted as runs of one colour, coalesced across bytes & rows, so a fill per run not per pixel
+static word runColour;
+static unsigned long runLength = 0;
+
+static void EndRun()
 {
-  // Load 2-bits-per-pixel screen-memory data
-  // insetBlocks skips that many cols of 8 pixels from the left AND right sides (used to re-draw the centre strip of the dials)
-  int widthBlocks = SCREEN_WIDTH / 8 - 2 * insetBlocks;
-  LCD_BEGIN_FILL(SCREEN_OFFSET_X + 8 * insetBlocks, SCREEN_OFFSET_Y + y, widthBlocks * 8, height);
+  if (runLength)
+  {
+    if ((runColour >> 8) == (runColour & 0xFF))
+      LCD_FILL_BYTE(runLength, (byte)runColour);  // black or white, the quicker fill
+    else
+      LCD_FILL_COLOUR(runLength, runColour);
+    runLength = 0;
+  }
+}
 
-  for (int strip = 0; strip < height / 8; strip++)
+static void Run(word colour, byte length)
+{
+  if (colour != runColour)
   {
-    for (int row = 0; row < 8; row++)
+    EndRun();
+    runColour = colour;
+  }
+  runLength += length;
+}
+
+static void DrawBitImage(const byte* pData, int y, int top, int height, int leftBlock, int widthBlocks, bool colour)
+{
+  // Load screen-memory data, 1-bit-per-pixel mono or 2-bits-per-pixel colour (at double width)
+  // The layout is strips of 8 rows, each strip is 32 blocks of 8 bytes, a byte per row
+  // Draws the image rows top..top+height and cols of 8 pixels leftBlock..leftBlock+widthBlocks, the image's top row is at y
+  LCD_BEGIN_FILL(SCREEN_OFFSET_X + 8 * leftBlock, SCREEN_OFFSET_Y + y + top, widthBlocks * 8, height);
+  for (int row = top; row < top + height; row++)
+  {
+    const byte* pByte = pData + (row / 8) * 8 * 32 + row % 8 + leftBlock * 8;
+    for (int col = 0; col < widthBlocks; col++)
     {
-      const byte* pByte = pData + row + insetBlocks * 8;
-      for (int col = 0; col < widthBlocks; col++)
-      {
-        byte Byte = pgm_read_byte_near(pByte);
-        if (Byte)
-          for (int pix = 0; pix < 4; pix++)
-          {
-            int idx = ((Byte >> (3 - pix)) & 0b00000001) | (((Byte >> (4 + (3 - pix))) & 0b00000001) << 1);
-            LCD_FILL_COLOUR(2, palette[idx]);
-          }
-        else
-          LCD_FILL_BYTE(8, 0x00);
-        pByte += 8;
-      }
+      byte Byte = pgm_read_byte_near(pByte);
+      if (!Byte)
+        Run(0x0000, 8);
+      else if (colour)
+        for (int pix = 0; pix < 4; pix++)
+        {
+          int idx = ((Byte >> (3 - pix)) & 0b00000001) | (((Byte >> (4 + (3 - pix))) & 0b00000001) << 1);
+          Run(palette[idx], 2);
+        }
+      else
+        for (int bit = 0; bit < 8; bit++)
+          Run((Byte & (0x80 >> bit)) ? 0xFFFF : 0x0000, 1);
+      pByte += 8;
     }
-    pData += 8 * 32;
   }
+  EndRun();
+}
+
+void DrawMonoBitImage(const byte* pData, int y, int height, int insetBlocks)
+{
+  // insetBlocks skips that many cols of 8 pixels from the left and right sides
+  DrawBitImage(pData, y, 0, height, insetBlocks, SCREEN_WIDTH / 8 - 2 * insetBlocks, false);
+}
+
+void DrawColourBitImage(const byte* pData, int y, int height, int insetBlocks)
+{
+  // insetBlocks skips that many cols of 8 pixels from the left AND right sides (used to re-draw the centre strip of the dials)
+  DrawBitImage(pData, y, 0, height, insetBlocks, SCREEN_WIDTH / 8 - 2 * insetBlocks, true);
+}
+
+void DrawBitImagePart(const byte* pData, int y, bool colour, int left, int top, int width, int height)
+{
+  // the blocks of 8 pixels covering left..left+width
+  int leftBlock = left / 8;
+  DrawBitImage(pData, y, top, height, leftBlock, (left + width + 7) / 8 - leftBlock, colour);
 }
 
 void DrawBackground()
@@ -120,11 +163,78 @@ void DrawSpaceArea()
   LCD_FILL_BYTE(LCD_BEGIN_FILL(LCD_WIDTH - SCREEN_OFFSET_X - 2, SCREEN_OFFSET_Y, 2, SCREEN_HEIGHT - DIALS_HEIGHT), 0xFF);  // 2 pixel lines either side
 }
 
+static void PatternRow(uint32_t mask, int x, int w, word fore, word back)
+{
+  // Stream a row of w pixels of a pattern that repeats every 32 pixels across the LCD, as runs
+  // mask's top bit is the pattern's left-most pixel, set for fore.  x is where the row starts on the LCD
+  // the pattern's runs, found once for the row
+  byte runs[32];
+  byte numRuns = 0, col = 0, len;
+  while (col < 32)
+  {
+    bool on = mask & (0x80000000UL >> col);
+    for (len = 1; col + len < 32 && (bool)(mask & (0x80000000UL >> (col + len))) == on; len++)
+      ;
+    runs[numRuns++] = len;
+    col += len;
+  }
+  // start part way into the run under x
+  byte run = 0, start = 0;
+  col = x % 32;
+  while (start + runs[run] <= col)
+    start += runs[run++];
+  len = start + runs[run] - col;
+  while (w > 0)
+  {
+    byte n = min((int)len, w);
+    Run((mask & (0x80000000UL >> col)) ? fore : back, n);
+    w -= n;
+    col += n;
+    if (++run == numRuns)
+    {
+      run = 0;
+      col = 0;
+    }
+    len = runs[run];
+  }
+}
+
+// the star field, picked once so a redraw puts the stars back where they were
+uint16_t starSeed = 0;
+#define STAR_SPACING 80 // pixels per star, on average
+
+static void Stars(unsigned long count, int x, int y)
+{
+  // Stream count pixels of the panel at x,y as black runs with a star after a random gap, already in raster order
+  // so no star needs its own window.  The panel's stars come from the field's seed & where the panel is
+  if (!starSeed)
+    starSeed = random(1, 0x10000);
+  uint16_t rnd = starSeed + 97u * (uint16_t)x + (uint16_t)y;
+  if (!rnd)
+    rnd = 1;
+  while (count)
+  {
+    // xorshift, not random(), so the stars can be put back
+    rnd ^= rnd << 7;
+    rnd ^= rnd >> 9;
+    rnd ^= rnd << 8;
+    unsigned long gap = rnd % (2 * STAR_SPACING);
+    if (gap >= count)
+      gap = count;
+    LCD_FILL_BYTE(gap, 0x00);
+    count -= gap;
+    if (count)
+    {
+      LCD_ONE_WHITE();
+      count--;
+    }
+  }
+}
+
 void DrawBackground(int x, int y, int w, int h)
 {
   // Fill-in a panel around the Elite screen
   unsigned long count = LCD_BEGIN_FILL(x, y, w, h);
-  byte scale;
   if (config::data.m_Background == loader::BeigeBackground) // Beige monitor
     LCD_FILL_COLOUR(count, RGB(0xF5, 0xF5, 0xDC));
   else if (config::data.m_Background == loader::ElkBackground)  // Electron-style pattern of squares
@@ -132,18 +242,9 @@ void DrawBackground(int x, int y, int w, int h)
     // best guess at the colours
     word fore = RGB(187, 184, 172);
     word back = RGB(0x20, 0x2B, 0x0B);
-    scale = 8;
     for (int row = 0; row < h; row++)
-    {
-      if ((y+row) % scale)
-        for (byte block = 0; block < w / scale; block++)
-        {
-          LCD_FILL_COLOUR(1, fore);
-          LCD_FILL_COLOUR(scale - 1, back);
-        }
-      else
-        LCD_FILL_COLOUR(w, fore);
-    }
+      PatternRow(((y + row) % 8) ? 0x80808080UL : 0xFFFFFFFFUL, x, w, fore, back);
+    EndRun();
   }
   else if (config::data.m_Background == loader::BeebBackground) // the BBC Micro owl icon
   {
@@ -158,40 +259,18 @@ void DrawBackground(int x, int y, int w, int h)
     for (int lcdY = y; lcdY < (y + h); lcdY++)
     {
       int row = lcdY % 24;
-      word rowData = pgm_read_word_near(owlIcon + row);  // reading beyond array is OK
-      for (int lcdX = x; lcdX < (x + w); lcdX++)
-      {
-        int col = lcdX % 32;
-        bool on = false;
-        if (row < 21)
-        {
-          if ((lcdY / 24) % 2)
-            col -= 15;
-          if (col)
-            on = rowData & (0x10000UL >> col);
-          else
-            on = colData & (0x8000 >> row); 
-        }
-        if (on)
-          LCD_ONE_WHITE();
-        else
-          LCD_ONE_BLACK();
-      }
+      uint32_t owl = 0;
+      if (row < 21)
+        owl = ((uint32_t)((colData >> (15 - row)) & 1) << 16) | pgm_read_word_near(owlIcon + row);
+      // 17 columns, at the left or, on alternate bands, from column 15
+      PatternRow(((lcdY / 24) % 2) ? owl : owl << 15, x, w, 0xFFFF, 0x0000);
     }
+    EndRun();
   }
+  else if (config::data.m_Background == loader::StarsBackground)
+    Stars(count, x, y);
   else  // black
     LCD_FILL_BYTE(count, 0x00);
-
-  if (config::data.m_Background == loader::StarsBackground) // stars
-  {
-    for (long star = 0; star < (w/8)*(h/10); star++)
-    {
-      int X = random(w);
-      int Y = random(h);
-      LCD_BEGIN_FILL(x + X, y + Y, 1, 1);
-      LCD_ONE_WHITE();
-    }
-  }
 }
 
 // Square root of integer, https://en.wikipedia.org/wiki/Integer_square_root
@@ -13,13 +13,14 @@ namespace loader
     StarsBackground
   };
   
-  void Init();
+  void Init(void (*done)());  // timed, calls done when the screen's ready
   void DrawBackground();
   void DrawSpaceArea();
 
   // Load screen-memory data
   void DrawMonoBitImage(const byte* pData, int y, int height, int insetBlocks = 0);
   void DrawColourBitImage(const byte* pData, int y, int height, int insetBlocks = 0);
+  void DrawBitImagePart(const byte* pData, int y, bool colour, int left, int top, int width, int height);  // a rect of the image drawn at y
   
   uint32_t Sqrt(uint32_t s);
 
@@ -0,0 +1,105 @@
+#include <Arduino.h>
+#include "Elite.h"
+#include "Profile.h"
+
+#ifdef ENABLE_PROFILE
+namespace profile {
+/*
+  Each stage keeps a running count, min, max & sum since the last dump, and a ring of its latest samples for the p95,
+  so a stage that runs several times a frame (the paints) doesn't crowd out one that runs now & then (the RTC).
+  micros() has a resolution of 4us on a Uno.  Costs ~450 bytes RAM.
+*/
+#define PROFILE_SAMPLES 20        // the p95 is the 2nd highest
+#define PROFILE_DUMP_FRAMES 500
+
+unsigned long startUS[NUM_STAGES];
+uint16_t samples[NUM_STAGES][PROFILE_SAMPLES];
+byte sampleCount[NUM_STAGES];
+byte nextSample[NUM_STAGES];
+uint16_t runCount[NUM_STAGES];
+uint16_t runMin[NUM_STAGES];
+uint16_t runMax[NUM_STAGES];
+uint32_t runSum[NUM_STAGES];
+uint16_t frames = 0;
+
+void Start(Stage stage)
+{
+  startUS[stage] = micros();
+}
+
+void Stop(Stage stage)
+{
+  // record the duration of the stage, longer than 65ms is clipped
+  unsigned long durationUS = micros() - startUS[stage];
+  uint16_t value = (durationUS > 0xFFFF) ? 0xFFFF : durationUS;
+  samples[stage][nextSample[stage]] = value;
+  if (++nextSample[stage] == PROFILE_SAMPLES)
+    nextSample[stage] = 0;
+  if (sampleCount[stage] < PROFILE_SAMPLES)
+    sampleCount[stage]++;
+  if (runCount[stage] == 0xFFFF)
+    return;
+  if (!runCount[stage]++ || value < runMin[stage])
+    runMin[stage] = value;
+  if (value > runMax[stage])
+    runMax[stage] = value;
+  runSum[stage] += value;
+}
+
+static void WriteWord(uint16_t value)
+{
+  Serial.write((byte)value);
+  Serial.write((byte)(value >> 8));
+}
+
+static void Dump()
+{
+  // write the record, see Profile.h
+  Serial.write('P');
+  Serial.write('F');
+  Serial.write(NUM_STAGES);
+  for (byte stage = 0; stage < NUM_STAGES; stage++)
+  {
+    // sort a copy of the ring for the p95, smallest first
+    byte count = sampleCount[stage];
+    uint16_t sorted[PROFILE_SAMPLES];
+    for (byte idx = 0; idx < count; idx++)
+    {
+      uint16_t value = samples[stage][idx];
+      byte pos = idx;
+      for (; pos && sorted[pos - 1] > value; pos--)
+        sorted[pos] = sorted[pos - 1];
+      sorted[pos] = value;
+    }
+    uint16_t runs = runCount[stage];
+    WriteWord(runs);
+    if (runs)
+    {
+      WriteWord(runMin[stage]);
+      WriteWord(runSum[stage] / runs);
+      WriteWord(sorted[(95 * count + 99) / 100 - 1]);
+      WriteWord(runMax[stage]);
+    }
+    else
+    {
+      for (byte field = 0; field < 4; field++)
+        WriteWord(0);
+    }
+    // start the next interval
+    runCount[stage] = 0;
+    runMax[stage] = 0;
+    runSum[stage] = 0;
+  }
+}
+
+void Frame()
+{
+  // another frame, time to dump?
+  if (++frames == PROFILE_DUMP_FRAMES)
+  {
+    frames = 0;
+    Dump();
+  }
+}
+}
+#endif
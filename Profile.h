@@ -0,0 +1,33 @@
+#pragma once
+
+// Per-stage frame timings, see ENABLE_PROFILE in Elite.h
+// Every PROFILE_DUMP_FRAMES frames a record is written to Serial, binary:
+//   'P' 'F' <stages>, then for each stage <samples> <min> <avg> <p95> <max>
+// stages is a byte, the rest are 16-bit little-endian.  samples, min, avg & max cover the frames since the last
+// record, p95 only the stage's last PROFILE_SAMPLES durations.  Times are microseconds
+namespace profile
+{
+  enum Stage
+  {
+    FaceVisibility,
+    VertexTransform,
+    LineRasterize,
+    XORPaint,
+    Paint,
+    RadarUpdate,
+    RTCRead,
+    InputPoll,
+    NUM_STAGES
+  };
+  void Start(Stage stage);
+  void Stop(Stage stage);
+  void Frame();   // call once per loop(), dumps the record now & then
+};
+
+#ifdef ENABLE_PROFILE
+#define PROFILE_START(_stage) profile::Start(profile::_stage)
+#define PROFILE_STOP(_stage) profile::Stop(profile::_stage)
+#else
+#define PROFILE_START(_stage)
+#define PROFILE_STOP(_stage)
+#endif
@@ -1,6 +1,8 @@
-#include "arduino.h"
-#include "SoftwareI2C.h"
+#include <Arduino.h>
+#include <SoftwareI2C.h>
 #include "Pins.h"
+#include "Elite.h"
+#include "Profile.h"
 #include "RTC.h"
 
 // real time clock
@@ -10,10 +12,14 @@ RTC rtc;
 SoftwareI2C softWire;
 #endif
 
+// how often Now() reads the RTC, millis() drifts
+#define RTC_SYNC_MS 60000UL
+
 RTC::RTC():
   m_Hour24(0x12),
   m_Minute(0),
-  m_Second(0)
+  m_Second(0),
+  m_bSynced(false)
 {
 }
 
@@ -26,14 +32,16 @@ void RTC::Setup()
 
 void RTC::ReadTime()
 {
-  // just the minutes and hours
-  // from register 1
+  // seconds, minutes and hours
+  // from register 0
+  PROFILE_START(RTCRead);
   softWire.beginTransmission(RTC_I2C_ADDRESS);
-  softWire.write((byte)0x01);
+  softWire.write((byte)0x00);
   softWire.endTransmission();
 
-  softWire.requestFrom(RTC_I2C_ADDRESS, 2);
+  softWire.requestFrom(RTC_I2C_ADDRESS, 3);
 
+  m_Second = BCD2Dec(softWire.read());
   m_Minute = BCD2Dec(softWire.read());
   byte Register2 = softWire.read();
   if (Register2 & 0x40)  // 12/24 hr
@@ -51,6 +59,43 @@ void RTC::ReadTime()
     // 24 hour mode
     m_Hour24 = BCD2Dec(Register2 & 0x3F);
   }
+  PROFILE_STOP(RTCRead);
+  Synced();
+}
+
+void RTC::Now()
+{
+  // the time without any bus traffic, the last read moved on by millis()
+  unsigned long elapsedMS = millis() - m_SyncMS;
+  if (!m_bSynced || elapsedMS >= RTC_SYNC_MS)
+  {
+    ReadTime();
+    return;
+  }
+  // less than a minute has passed
+  m_Hour24 = m_SyncHour24;
+  m_Minute = m_SyncMinute;
+  m_Second = m_SyncSecond + (byte)(elapsedMS / 1000);
+  if (m_Second >= 60)
+  {
+    m_Second -= 60;
+    if (++m_Minute >= 60)
+    {
+      m_Minute = 0;
+      if (++m_Hour24 >= 24)
+        m_Hour24 = 0;
+    }
+  }
+}
+
+void RTC::Synced()
+{
+  // the RTC has just been read, or set, Now() works from here
+  m_SyncHour24 = m_Hour24;
+  m_SyncMinute = m_Minute;
+  m_SyncSecond = m_Second;
+  m_SyncMS = millis();
+  m_bSynced = true;
 }
 
 byte RTC::ReadSecond()
@@ -86,6 +131,7 @@ void RTC::WriteTime()
   softWire.write(Dec2BCD(m_Minute));
   softWire.write(Dec2BCD(m_Hour24));  // 24 hr mode
   softWire.endTransmission();
+  Synced();
 }
 #else
 void RTC::Setup()
@@ -96,6 +142,10 @@ void RTC::ReadTime( )
 {
 }
 
+void RTC::Now()
+{
+}
+
 byte RTC::ReadSecond()
 {
   return m_Second;
@@ -13,6 +13,7 @@ class RTC
     byte BCD2Dec(byte BCD);
     byte Dec2BCD(byte Dec);
     void ReadTime();
+    void Now();         // as ReadTime() but extrapolated with millis(), the RTC is only read once a minute
     byte ReadSecond();
     byte ReadMinute();
     void WriteTime();
@@ -23,6 +24,16 @@ class RTC
     byte m_Unused;      // was day
 
     static bool CheckPeriod(unsigned long& Timer, unsigned long PeriodMS);
+
+  private:
+    void Synced();
+
+    // the time at the last read, for Now()
+    bool m_bSynced;
+    byte m_SyncHour24;
+    byte m_SyncMinute;
+    byte m_SyncSecond;
+    unsigned long m_SyncMS;
 };
 
 extern RTC rtc;
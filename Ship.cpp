@@ -4,12 +4,12 @@
 
 namespace ship {
 // The ship data is from the original game.  See, for example, https://github.com/markmoxon/disc-elite-beebasm/tree/master/1-source-files/main-sources
-// Visibility values are *NOT* stored. Culling detail probably only matters when the lines are being XOR'd -- distant ships may end up being a mess.
+// Vertex & edge visibility values are stored, packed into space the other fields don't use. Distant ships drop their detail lines (see DrawShip)
 // Only the *SIGNS* of the original normals are stored. See computeNewNormals
 
 // Various packing/conversion macros
-#define VERTEX(x,y,z,f1,f2,f3,f4,vis) {x,y,z, (f1==15)?0xFFFF:(1U<<f1)|(1U<<f2)|(1U<<f3)|(1U<<f4)},
-#define EDGE(v1,v2,f1,f2,vis) {v1,v2,f1,f2},
+#define VERTEX(x,y,z,f1,f2,f3,f4,vis) {x,vis,y,z, (f1==15)?0xFFFF:(1U<<f1)|(1U<<f2)|(1U<<f3)|(1U<<f4)},
+#define EDGE(v1,v2,f1,f2,vis) {v1,v2,f1,f2,vis},
 #define SIGN(_n) ((_n>=0)?+1:-1)
 #define FACE(nx,ny,nz,vis) {SIGN(nx),SIGN(ny),SIGN(nz)},
 #define SHIP_ARRAY(_a) _a, (uint8_t)(sizeof(_a)/sizeof(_a[0]))
@@ -6,13 +6,17 @@ namespace ship
 {
   struct Vertex
   {
-    int16_t  x, y, z;
+    int16_t  x:11;          // the blueprints are all within +/-254
+    uint16_t visibility:5;  // 0..31, detail is culled when the ship is distant
+    int16_t  y, z;
     uint16_t faces;
   };
   
   struct Edge
   {
-    uint8_t vertex1, vertex2, face1, face2;
+    uint8_t vertex1, vertex2;
+    uint8_t face1:4, face2:4;
+    uint8_t visibility;
   };
   
   struct Face
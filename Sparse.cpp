@@ -13,8 +13,9 @@ namespace sparse {
   
   Each row is a contiguous block of bytes representing runs of horizontal pixels. The runs are sorted from left to right (but they may grow into each other; Draw() handles this).  
   All the run data is in a single array of bytes, pool[]. rows[r] stores the number of bytes in row r.
-  Setting a pixel at (row, col) is a matter of finding the start of the row block by adding values in rows then scanning across the block to find where col belongs and 
-  either inserting a new single pixel entry, or extending an existing run. Adding a byte to a run means shuffling up all the subsequent bytes.
+  Setting a run of pixels on a row is a matter of finding the start of the row block by adding values in rows then scanning across the block to find where the run belongs and 
+  either inserting a new entry, or merging it with an existing run. Adding bytes to a run means shuffling up all the subsequent bytes.
+  Lines are drawn a row-run at a time, so a shallow line costs one of these per row, not one per pixel.
   Drawing is a matter of scanning all the rows and run data and sending bands of black/white pixel data to the LCD.
 
   There are two variations of the algorithm, selected by ENABLE_SPARSE_WIDE
@@ -67,6 +68,8 @@ const int SPARSE_POOL_SIZE = 1024;
 #define SPARSE_GET_LEN(_last, _ptr)    (((_last) || *_ptr < *(_ptr+1)) ? 1 : ((*(_ptr+1) == NUL) ? *(_ptr+2) : *(_ptr+1)))
 // number of bytes in the entry at _ptr in the pool
 #define SPARSE_GET_SIZE(_last, _ptr)   (((_last) || *_ptr < *(_ptr+1)) ? 1 : ((*(_ptr+1) == NUL) ? 3 : 2))
+// number of bytes needed to encode the run
+#define SPARSE_ENCODED_SIZE(_x, _len)  (((_len) == 1) ? 1 : (((_len) <= (_x)) ? 2 : 3))
 
 #else
 // Drawn as left and right halves
@@ -80,318 +83,264 @@ const int SPARSE_POOL_SIZE = 550;
 #define SPARSE_GET_LEN(_last, _ptr)    ((*(_ptr) & 0x80)?*((_ptr) + 1):1)
 // number of bytes in the entry at _ptr in the pool
 #define SPARSE_GET_SIZE(_last, _ptr)   ((*(_ptr) & 0x80)?2:1)
-// true if data at _ptr is 2-bytes
-#define SPARSE_IS_DUAL(_ptr)     (*(_ptr) & 0x80)
-// set the data to be 2-byte
-#define SPARSE_SET_DUAL(_ptr)    (*(_ptr) |= 0x80)
+// number of bytes needed to encode the run
+#define SPARSE_ENCODED_SIZE(_x, _len)  (((_len) == 1) ? 1 : 2)
 #endif
 
 byte rows[SPARSE_ROWS]; // number of bytes in row's sparse representation
 byte pool[SPARSE_POOL_SIZE]; // representations go here ("values", "cols"!)
 uint16_t pool_top;    // index to next free byte
-byte* cachePtr = NULL;
-byte cacheY = INF;
-byte cacheX = INF;
-bool cacheLast = false;
-const int numMidRows = 4;
-uint16_t sumToMidRow[numMidRows]; // cache the sum of the rows up to n*SPARSE_ROWS/numMidRows
 uint16_t highWater = 0;
 #ifdef DEBUG  
 #define SET_HIGHWATER(_rhs) highWater = _rhs
 #else
 #define SET_HIGHWATER(_rhs)
 #endif
+#if defined(DEBUG) || defined(LCD_HOST) || defined(ENABLE_PROFILE)
+// only where it's read
+uint32_t movedBytes = 0;
+#define ADD_MOVED(_count) movedBytes += _count
+#else
+#define ADD_MOVED(_count)
+#endif
 
-static bool Insert(byte y, byte* pValue, byte value, byte value2 = 0)
+/*
+  The row index, finds the start of a row's data in the pool without adding up all the rows before it.
+  Selected by ENABLE_SPARSE_FENWICK, the trade-off for the 168-row Small window (176 for Large) is:
+                          RAM (bytes)   find row start      Insert() update
+    bands of 16 rows      22 (22)       <= 15 row adds      <= 10 band adds
+    Fenwick tree          338 (354)     <= 8 node adds      <= 8 node adds
+  (The original 4 mid-rows were 8 bytes, <= 41 row adds and 3 multiply/divide compares per Insert().)
+  A Uno can just afford the bands, a board with more RAM can use the tree.  SPARSE_BAND_BITS tunes the bands.
+*/
+#ifdef ENABLE_SPARSE_FENWICK
+// Fenwick (binary indexed) tree over rows[]. rowIndex[i] is the sum of rows[i - (i & -i)] .. rows[i - 1]
+uint16_t rowIndex[SPARSE_ROWS + 1];
+
+static byte* RowStart(byte y)
 {
-  // inserts a new byte *at* pValue. Bytes above are shuffled
-  // does most of the work, shuffles up the pool to make room for the new value
-  // true if there was room
-  // Also handles two bytes, if value2 != 0
+  // the start of the data for row y, the sum of rows[0] .. rows[y - 1]
+  uint16_t offset = 0;
+  for (int idx = y; idx; idx &= idx - 1)
+    offset += rowIndex[idx];
+  return pool + offset;
+}
 
-  if (value2)
-  {
-    // special case, insert NUL & 2
-    if (pool_top < SPARSE_POOL_SIZE - 1)
-    {
-      // there's room for 2 bytes
-      // shuffle pool bytes up
-      memmove(pValue + 2, pValue, (pool + pool_top) - pValue);
-      *pValue = value;
-      *(pValue + 1) = value2;
-      pool_top += 2;
-      rows[y] += 2;
-      for (int midRow = 1; midRow < numMidRows; midRow++)
-        if (y < midRow*SPARSE_ROWS/numMidRows)
-          sumToMidRow[midRow] += 2;
-      SET_HIGHWATER(max(highWater, pool_top));
-      return true;
-    }
-  }
-  else if (pool_top < SPARSE_POOL_SIZE)
-  {
-    // there's room
-    // shuffle pool bytes up
-    memmove(pValue + 1, pValue, (pool + pool_top) - pValue);
-    *pValue = value;
-    pool_top++;
-    rows[y]++;
-    for (int midRow = 1; midRow < numMidRows; midRow++)
-      if (y < midRow*SPARSE_ROWS/numMidRows)
-        sumToMidRow[midRow]++;
-    SET_HIGHWATER(max(highWater, pool_top));
-    return true;
-  }
-  SET_HIGHWATER(SPARSE_POOL_SIZE);
-  return false;
+static void UpdateRowIndex(byte y, byte count)
+{
+  // count bytes were added to row y
+  for (int idx = y + 1; idx <= SPARSE_ROWS; idx += idx & -idx)
+    rowIndex[idx] += count;
 }
+#else
+#define SPARSE_BAND_BITS 4
+const int numBands = (SPARSE_ROWS + (1 << SPARSE_BAND_BITS) - 1) >> SPARSE_BAND_BITS;
+#ifdef ENABLE_SPARSE_SLACK
+/*
+  Slack: each band of rows has its own region of the pool, bandStart[b] .. bandStart[b + 1].
+  The first bandTop[b] - bandStart[b] bytes are used, the rest is slack.  An Insert() only shuffles up the rest of its band, 
+  not the rest of the pool.  When a band runs out of slack the free space is re-spread evenly across all the bands.
+  Costs 2*numBands+2 more bytes than the plain bands.  Painting jumps over the slack at each band.
+*/
+uint16_t bandStart[numBands + 1] = {0};
+uint16_t bandTop[numBands];
+#else
+// The sum of the rows before each band of 2^SPARSE_BAND_BITS rows
+uint16_t rowIndex[numBands];
+#endif
 
-#ifdef ENABLE_SPARSE_WIDE
-static void Pixel(byte x, byte y)
+static byte* RowStart(byte y)
 {
-  // set the pixel in the sparse data
-  if (y >= SPARSE_ROWS || x >= SPARSE_COLS)
-    return;
+  // the start of the data for row y, from the start of its band
+  byte band = y >> SPARSE_BAND_BITS;
+#ifdef ENABLE_SPARSE_SLACK
+  byte* thisPtr = pool + bandStart[band];
+#else
+  byte* thisPtr = pool + rowIndex[band];
+#endif
+  byte* rowPtr = rows + (band << SPARSE_BAND_BITS);
+  byte* endPtr = rows + y;
+  while (rowPtr < endPtr)
+    thisPtr += *rowPtr++;
+  return thisPtr;
+}
 
-  if (cacheY == y && cacheX == x)
-  {
-    // cache the last location to quickly append to horizontal sequences
-    byte* thisPtr = cachePtr;
-    byte bytes = SPARSE_GET_SIZE(cacheLast, thisPtr);
-    x = SPARSE_GET_X(thisPtr);
-    cacheLast = false;
-    if (bytes == 1)
-    {
-      if (x >= 2) // 2 bytes will work
-      {
-        if (!Insert(y, thisPtr + 1, 2))  // len=2
-          cacheY = INF;
-      }
-      else // need 3
-      {
-        if (!Insert(y, thisPtr + 1, NUL, 2))  // len=2, as 3 bytes
-          cacheY = INF;
-      }
-    }
-    else if (bytes == 2)
-    {
-      thisPtr++;
-      if (x > *thisPtr)
-        (*thisPtr)++;   // len++
-      else if (Insert(y, thisPtr++, NUL)) // need to go to 3 bytes
-        (*thisPtr)++;   // len++
-      else
-        cacheY = INF;
-    }
-    else // 3 bytes
-    {
-      thisPtr += 2;
-      (*thisPtr)++;   // len++
-    }
-    cacheX++;
-    return;
-  }
+static void UpdateRowIndex(byte y, byte count)
+{
+#ifdef ENABLE_SPARSE_SLACK
+  // count bytes were added to row y, in its band
+  bandTop[y >> SPARSE_BAND_BITS] += count;
+#else
+  // count bytes were added to row y, bump the bands after it
+  for (byte band = (y >> SPARSE_BAND_BITS) + 1; band < numBands; band++)
+    rowIndex[band] += count;
+#endif
+}
+#endif
 
-  byte* thisPtr = pool;
-  byte* rowPtr = rows;
-  int startRow = 0;
-  // check short-cuts
-  for (int midRow = numMidRows-1; midRow; midRow--)
-    if (y >= midRow*SPARSE_ROWS/numMidRows)
-    {
-      startRow = midRow*SPARSE_ROWS/numMidRows;
-      thisPtr += sumToMidRow[midRow];
-      rowPtr  += startRow;
-      break;
-    }
-  // add up the bytes per row to find the start of the data for row y
-  for (int row = startRow; row < y; row++, rowPtr++)
-    thisPtr += *rowPtr;
+#ifdef ENABLE_SPARSE_SLACK
+#ifdef ENABLE_SPARSE_FENWICK
+#error ENABLE_SPARSE_SLACK uses the bands as the row index, so excludes ENABLE_SPARSE_FENWICK
+#endif
+static void MoveBand(byte band, uint16_t start)
+{
+  // move the band's data to start
+  uint16_t used = bandTop[band] - bandStart[band];
+  memmove(pool + start, pool + bandStart[band], used);
+  ADD_MOVED(used);
+  bandStart[band] = start;
+  bandTop[band] = start + used;
+}
 
-  byte bytesInRow = *rowPtr;
-  while (bytesInRow && ((int)x - (int)(SPARSE_GET_X(thisPtr) + SPARSE_GET_LEN(bytesInRow == 1, thisPtr))) >= 1)
+static void Rebalance(byte needyBand, byte count)
+{
+  // re-spread the free space evenly, with count extra bytes for the needy band
+  uint16_t slack = (SPARSE_POOL_SIZE - pool_top - count) / numBands;
+  uint16_t newStart[numBands];
+  uint16_t start = 0;
+  for (byte band = 0; band < numBands; band++)
   {
-    byte bytes = SPARSE_GET_SIZE(bytesInRow == 1, thisPtr);
-    bytesInRow -= bytes;
-    thisPtr += bytes;
+    newStart[band] = start;
+    start += bandTop[band] - bandStart[band] + slack;
+    if (band == needyBand)
+      start += count;
   }
-  cacheY = INF;
-  if (!bytesInRow) // append. got to the end without finding a place to insert/update
+  // bands moving up are moved top-down, then those moving down are moved bottom-up, so no data is overwritten
+  for (int band = numBands - 1; band >= 0; band--)
+    if (newStart[band] > bandStart[band])
+      MoveBand(band, newStart[band]);
+  for (int band = 0; band < numBands; band++)
+    if (newStart[band] < bandStart[band])
+      MoveBand(band, newStart[band]);
+}
+#endif
+
+static bool Insert(byte y, byte*& pValue, byte count)
+{
+  // makes room for count new bytes *at* pValue in row y. Bytes above are shuffled up
+  // true if there was room. pValue is updated if the pool was rebalanced
+  if (pool_top + count > SPARSE_POOL_SIZE)
   {
-    Insert(y, thisPtr, x);
-    cacheX = x + 1;
-    cacheY = y;
-    cachePtr = thisPtr;
-    cacheLast = true;
+    SET_HIGHWATER(SPARSE_POOL_SIZE);
+    return false;
   }
-  // thisPtr is an item with an x larger than ours, or within 1 of ours
-  else if (x == SPARSE_GET_X(thisPtr) - 1)  // expand thisPtr left
+  if (count)
   {
-    byte bytes = SPARSE_GET_SIZE(bytesInRow == 1, thisPtr);
-    (*thisPtr)--;     // x--
-    if (bytes == 1)
-    {
-      if (x >= 2) // 2 bytes will work
-        Insert(y, thisPtr + 1, 2);  // len=2
-      else // need 3
-        Insert(y, thisPtr + 1, NUL, 2);  // len=2, as 3 bytes
-    }
-    else if (bytes == 2)
+#ifdef ENABLE_SPARSE_SLACK
+    byte band = y >> SPARSE_BAND_BITS;
+    if (bandTop[band] + count > bandStart[band + 1])
     {
-      thisPtr++;
-      if (x > *thisPtr)
-        (*thisPtr)++;   // len++
-      else if (Insert(y, thisPtr++, NUL)) // need to go to 3 bytes
-        (*thisPtr)++;   // len++
-    }
-    else // 3 bytes
-    {
-      thisPtr += 2;
-      (*thisPtr)++;   // len++
+      uint16_t offset = pValue - (pool + bandStart[band]);
+      Rebalance(band, count);
+      pValue = pool + bandStart[band] + offset;
     }
+    byte* pTop = pool + bandTop[band];
+#else
+    byte* pTop = pool + pool_top;
+#endif
+    // shuffle bytes up
+    memmove(pValue + count, pValue, pTop - pValue);
+    ADD_MOVED(pTop - pValue);
+    pool_top += count;
+    rows[y] += count;
+    UpdateRowIndex(y, count);
+    SET_HIGHWATER(max(highWater, pool_top));
   }
-  else if (x == (SPARSE_GET_X(thisPtr) + SPARSE_GET_LEN(bytesInRow == 1, thisPtr))) // expand thisPtr right
+  return true;
+}
+
+static void Encode(byte* pValue, byte x, byte len)
+{
+  // write the run at pValue, which has room for SPARSE_ENCODED_SIZE(x, len) bytes
+#ifdef ENABLE_SPARSE_WIDE
+  *pValue++ = x;
+  if (len > 1)
   {
-    byte bytes = SPARSE_GET_SIZE(bytesInRow == 1, thisPtr);
-    x = SPARSE_GET_X(thisPtr);
-    if (bytes == 1)
-    {
-      if (x >= 2) // 2 bytes will work
-        Insert(y, thisPtr + 1, 2);  // len=2
-      else // need 3
-        Insert(y, thisPtr + 1, NUL, 2);  // len=2, as 3 bytes
-    }
-    else if (bytes == 2)
-    {
-      thisPtr++;
-      if (x > *thisPtr)
-        (*thisPtr)++;   // len++
-      else if (Insert(y, thisPtr++, NUL)) // need to go to 3 bytes
-        (*thisPtr)++;   // len++
-    }
-    else // 3 bytes
-    {
-      thisPtr += 2;
-      (*thisPtr)++;   // len++
-    }
+    if (len > x)
+      *pValue++ = NUL;  // 3 bytes
+    *pValue = len;
   }
-  else if (x < SPARSE_GET_X(thisPtr))     // insert before thisPtr
+#else
+  if (len > 1)
   {
-    Insert(y, thisPtr, x);
-    cacheX = x + 1;
-    cacheY = y;
-    cachePtr = thisPtr;
-    cacheLast = bytesInRow == 1;
+    *pValue++ = x | 0x80;
+    *pValue = len;
   }
+  else
+    *pValue = x;
+#endif
 }
-#else
-static void Pixel(byte x, byte y)
-{
-  // set the pixel in the sparse data
-  if (y >= SPARSE_ROWS || x >= SPARSE_COLS)
-    return;
 
-  if (cacheY == y && cacheX == x)
-  {
-    // cached the last location to quickly append to horizontal sequences
-    if (SPARSE_IS_DUAL(cachePtr))
-    {
-      (*(cachePtr + 1))++;
-    }
-    else if (Insert(cacheY, cachePtr + 1, 2))  // len=2
-    {
-      SPARSE_SET_DUAL(cachePtr);
-    }
-    else
-      cacheY = INF;
-    cacheX++;
+static void Span(byte x, byte y, byte len)
+{
+  // set len pixels from column x of row y in the sparse data
+  // A single pool operation: the run is either merged with a run it touches or inserted before the first run to its right
+  if (y >= SPARSE_ROWS || x >= SPARSE_COLS || !len)
     return;
-  }
+  if (x + len > SPARSE_COLS)
+    len = SPARSE_COLS - x;
 
-  byte* thisPtr = pool;
-  byte* rowPtr = rows;
-  int startRow = 0;
-  // check short-cuts
-  for (int midRow = numMidRows-1; midRow; midRow--)
-    if (y >= midRow*SPARSE_ROWS/numMidRows)
-    {
-      startRow = midRow*SPARSE_ROWS/numMidRows;
-      thisPtr += sumToMidRow[midRow];
-      rowPtr  += startRow;
-      break;
-    }
-  // add up the bytes per row to find the start of the data for row y
-  for (int row = startRow; row < y; row++, rowPtr++)
-    thisPtr += *rowPtr;
+  byte* thisPtr = RowStart(y);
 
-  byte bytesInRow = *rowPtr;
-  while (bytesInRow && ((int)x - (int)(SPARSE_GET_X(thisPtr) + SPARSE_GET_LEN(false, thisPtr))) >= 1)
-  {
-    bytesInRow -= SPARSE_GET_SIZE(false, thisPtr);
-    thisPtr += SPARSE_GET_SIZE(false, thisPtr);
-  }
-  cacheX = INF;
-  if (!bytesInRow) // append. got to the end without finding a place to insert/update
-  {
-    Insert(y, thisPtr, x);
-    cacheX = x + 1;
-    cacheY = y;
-    cachePtr = thisPtr;
-  }
-  // thisPtr is an item with an x larger than ours, or within 1 of ours
-  else if (x == SPARSE_GET_X(thisPtr) - 1)  // expand thisPtr left
+  // skip the runs which end before x (and don't touch it)
+  byte bytesInRow = rows[y];
+  while (bytesInRow && (int)(SPARSE_GET_X(thisPtr) + SPARSE_GET_LEN(bytesInRow == 1, thisPtr)) < (int)x)
   {
-    if (SPARSE_IS_DUAL(thisPtr))
-    {
-      (*thisPtr)--;     // x--
-      thisPtr++;
-      (*thisPtr)++;   // len++
-    }
-    else if (Insert(y, thisPtr + 1, 2))  // len=2
-    {
-      SPARSE_SET_DUAL(thisPtr);
-      (*thisPtr)--;     // x--
-    }
-  }
-  else if (x == (SPARSE_GET_X(thisPtr) + SPARSE_GET_LEN(false, thisPtr)))  // expand thisPtr right
-  {
-    if (SPARSE_IS_DUAL(thisPtr))
-    {
-      thisPtr++;
-      (*thisPtr)++;   // len++
-    }
-    else
-    {
-      if (Insert(y, thisPtr + 1, 2))  // len=2
-      {
-        SPARSE_SET_DUAL(thisPtr);
-      }
-    }
+    byte bytes = SPARSE_GET_SIZE(bytesInRow == 1, thisPtr);
+    bytesInRow -= bytes;
+    thisPtr += bytes;
   }
-  else if (x < SPARSE_GET_X(thisPtr))     // insert before thisPtr
+  int end = x + len;
+  byte bytes = 0;
+  if (bytesInRow && SPARSE_GET_X(thisPtr) <= end)
   {
-    Insert(y, thisPtr, x);
-    cacheX = x + 1;
-    cacheY = y;
-    cachePtr = thisPtr;
+    // thisPtr touches or overlaps the new run, merge them. It can only grow, so may need more bytes
+    int runX = SPARSE_GET_X(thisPtr);
+    int runEnd = runX + SPARSE_GET_LEN(bytesInRow == 1, thisPtr);
+    bytes = SPARSE_GET_SIZE(bytesInRow == 1, thisPtr);
+    if (runX < x)
+      x = runX;
+    if (runEnd > end)
+      end = runEnd;
+    len = end - x;
   }
+  // else insert before thisPtr (or append)
+  byte* pInsert = thisPtr + bytes;
+  if (Insert(y, pInsert, SPARSE_ENCODED_SIZE(x, len) - bytes))
+    Encode(pInsert - bytes, x, len);
 }
-#endif
 
 void Clear()
 {
   // prepare for another render
   memset(rows, 0x00, sizeof(rows));
   pool_top = 0;
-  for (int midRow = 0; midRow < numMidRows; midRow++)
-    sumToMidRow[midRow] = 0;
+#ifdef ENABLE_SPARSE_SLACK
+  // share the pool evenly between the bands
+  for (byte band = 0; band < numBands; band++)
+    bandStart[band] = bandTop[band] = band * (SPARSE_POOL_SIZE / numBands);
+  bandStart[numBands] = SPARSE_POOL_SIZE;
+#else
+  memset(rowIndex, 0x00, sizeof(rowIndex));
+#endif
+}
+
+static void Run(int x0, int x1, int y, int minX, int maxX)
+{
+  // set the pixels x0..x1 (inclusive) on row y, clipped to minX..maxX
+  if (x0 < minX)
+    x0 = minX;
+  if (x1 >= maxX)
+    x1 = maxX - 1;
+  if (x0 <= x1 && 0 <= y && y < SPARSE_ROWS)
+    Span(x0 - minX, y, x1 - x0 + 1);
 }
 
 void Line(int x0, int y0, int x1, int y1, int minX, int maxX)
 {
-  // Draw a line {x0, y0} to {x1, y1}. Clipped to minX..maxX
+  // Draw a line {x0, y0} to {x1, y1}. Clipped to minX..maxX and the rows
   // Always drawn left-to-right
-  // Results in a series of calls to Pixel()
+  // The Bresenham steps along each row are gathered into a run, each run is a single call to Span()
   int dx, dy;
   int     sy;
   int er, e2;
@@ -401,21 +350,65 @@ void Line(int x0, int y0, int x1, int y1, int minX, int maxX)
     dx = x0; x0 = x1; x1 = dx;
     dy = y0; y0 = y1; y1 = dy;
   }
+  // trivially outside?
+  if (x1 < minX || x0 >= maxX || (y0 < 0 && y1 < 0) || (y0 >= SPARSE_ROWS && y1 >= SPARSE_ROWS))
+    return;
 
   dx = x1 - x0;
   dy = (y1 >= y0) ? y0 - y1 : y1 - y0;
   sy = (y0 <  y1) ? 1       : -1;
-  er = dx + dy;
 
-  while (1)
+  // Clip the start. k x-steps and m y-steps are needed to reach the window
+  int k = minX - x0;
+  int m = (sy > 0) ? -y0 : y0 - (SPARSE_ROWS - 1);
+  if (k < 0)
+    k = 0;
+  if (m < 0)
+    m = 0;
+  if (k || m)
   {
-    if (minX <= x0 && x0 < maxX)
-      Pixel(x0 - minX, y0);
-    else if (x0 > maxX)   // clip
+    // Jump straight to the first pixel inside, exactly where the stepping below would have got to.
+    // A shallow line has one pixel per column, at m = (2|dy|k + dx)/2dx, a steep line one per row, at k = (2dxm + |dy|)/2|dy|
+    long adx = dx, ady = -dy;
+    if (adx >= ady)
+    {
+      long mAtK = (2*ady*k + adx) / (2*adx);
+      if (mAtK < m)
+        k = (2*adx*m - adx + 2*ady - 1) / (2*ady);  // first column on row m
+      else
+        m = mAtK;
+    }
+    else
+    {
+      long kAtM = (2*adx*m + ady) / (2*ady);
+      if (kAtM < k)
+        m = (2*ady*k - ady + 2*adx - 1) / (2*adx);  // first row in column k
+      else
+        k = kAtM;
+    }
+    if (k > dx || m > -dy)
       return;
+    x0 += k;
+    y0 += sy*m;
+  }
+  er = dx + dy + (int)((long)k*dy + (long)m*dx);
+
+  int runX = x0;  // start of the run on this row
+  while (1)
+  {
     if ((x0 == x1) && (y0 == y1))
+    {
+      Run(runX, x0, y0, minX, maxX);
       break;
+    }
     e2 = 2 * er;
+    if (e2 <= dx)
+    {
+      // about to change rows, the run ends here
+      if (runX >= maxX)   // clip
+        return;
+      Run(runX, x0, y0, minX, maxX);
+    }
     if (e2 >= dy)
     {
       er += dy;
@@ -425,25 +418,169 @@ void Line(int x0, int y0, int x1, int y1, int minX, int maxX)
     {
       er += dx;
       y0 += sy;
+      if (y0 < 0 || y0 >= SPARSE_ROWS)   // clip
+        return;
+      runX = x0;
     }
   }
 }
 
+#ifdef ENABLE_SPARSE_SLACK
+// jump over the slack to the start of the next band
+#define SKIP_SLACK(_row, _pRowStart) if (!((_row) & ((1 << SPARSE_BAND_BITS) - 1))) _pRowStart = pool + bandStart[(_row) >> SPARSE_BAND_BITS];
+#else
+#define SKIP_SLACK(_row, _pRowStart)
+#endif
+
+/*
+  Bounding box: a small ship, or one approaching, covers only part of the window.  Outside the box it was drawn in last
+  frame and the box it's drawn in this frame the window is already blank, so only the union of the two is painted.
+*/
+int boxMinX = 0, boxMinY = 0, boxMaxX = SHIP_WINDOW_SIZE, boxMaxY = SHIP_WINDOW_SIZE;          // last frame's, max is exclusive
+int paintMinX = 0, paintMinY = 0, paintMaxX = SHIP_WINDOW_SIZE, paintMaxY = SHIP_WINDOW_SIZE;  // the union with this frame's
+
+static bool Clip(int originX, int& minRow, int& maxRow, int& minCol, int& maxCol, byte*& pRowStart)
+{
+  // limit minRow..maxRow to the box and return its columns, relative to originX. false if there's nothing to paint
+  minCol = max(paintMinX - originX, 0);
+  maxCol = min(paintMaxX - originX, SPARSE_COLS);
+  if (minRow < paintMinY)
+  {
+    minRow = paintMinY;
+    pRowStart = NULL; // find the new first row
+  }
+  if (maxRow > paintMaxY)
+    maxRow = paintMaxY;
+  if (minRow >= maxRow || minCol >= maxCol)
+  {
+    pRowStart = NULL;
+    return false;
+  }
+  return true;
+}
+
+#ifdef ENABLE_SPARSE_DIRTY
+/*
+  Dirty rows: the signature of each row as it was last painted, a hash of its sparse data and any text XOR'd into it.
+  A row with the same signature as last frame is already on the LCD so isn't painted again, which skips the blank rows
+  above & below the ship and any that haven't moved.  Each band of changed rows gets its own LCD window.
+  Costs 2 bytes per row for each pass.  A hash collision (~1 in 65536 changed rows) would leave a stale row, so a few
+  rows are repainted regardless each frame, a band that works down the bounding box (outside it the window's blank).
+*/
+const int SPARSE_PASSES = SHIP_WINDOW_SIZE / SPARSE_COLS;
+uint16_t signatures[SPARSE_PASSES][SPARSE_ROWS];
+byte invalidFrames = 0;             // frames to go before the signatures can be trusted
+#define SPARSE_REFRESH_BITS 2       // refresh 4 rows per frame
+byte refreshBand = 0;
+
+static uint16_t Crc(uint16_t crc, byte data)
+{
+  // CRC-CCITT (reflected, as avr-libc's _crc_ccitt_update), any change of a run's x or length alters it
+  data ^= (byte)crc;
+  data ^= data << 4;
+  return ((((uint16_t)data << 8) | (crc >> 8)) ^ (byte)(data >> 4) ^ ((uint16_t)data << 3));
+}
+
+static bool RowChanged(int originX, int row, const byte* pValue, byte rowLen, uint16_t seed)
+{
+  // true if the row's signature differs from last time, which is then updated, or it's in the refresh band
+  uint16_t hash = Crc(seed, rowLen);
+  while (rowLen--)
+    hash = Crc(hash, *pValue++);
+  uint16_t* pSignature = &signatures[originX / SPARSE_COLS][row];
+  bool same = *pSignature == hash;
+  *pSignature = hash;
+  if (((row - paintMinY) >> SPARSE_REFRESH_BITS) == refreshBand)
+    return true;
+  return !same || invalidFrames;
+}
+
+static uint16_t TextSignature(byte textX, byte textY, const char* str, text::CharReader charLoader)
+{
+  // hash the text & where it is, so the XOR'd rows are repainted when it changes
+  uint16_t hash = Crc(Crc(0xFFFF, textX), textY);
+  char ch;
+  while ((ch = charLoader(str++)))
+    hash = Crc(hash, ch);
+  return hash;
+}
+
+// skip the row if it's unchanged. Opens a new window unless the row follows on from the last one painted
+#define SKIP_CLEAN_ROW(_originX, _row, _maxRow, _pValue, _rowLen, _seed, _clipMinCol, _clipMaxCol, _nextRow, _minCol, _maxCol) \
+  { \
+    if (!RowChanged(_originX, _row, _pValue, _rowLen, _seed)) \
+      continue; \
+    if ((_row) != (_nextRow)) \
+    { \
+      _minCol = _clipMinCol; \
+      _maxCol = _clipMaxCol; \
+      LCD_BEGIN_FILL(SHIP_WINDOW_ORIGIN_X + (_originX) + (_minCol), SHIP_WINDOW_ORIGIN_Y + (_row), (_maxCol) - (_minCol), (_maxRow) - (_row)); \
+    } \
+    _nextRow = (_row) + 1; \
+  }
+#endif
+
+void Bounds(int minX, int minY, int maxX, int maxY)
+{
+  // a new frame, drawn within minX..maxX, minY..maxY (inclusive)
+  minX = max(minX, 0);
+  minY = max(minY, 0);
+  maxX = min(maxX + 1, SHIP_WINDOW_SIZE);
+  maxY = min(maxY + 1, SHIP_WINDOW_SIZE);
+  paintMinX = min(minX, boxMinX);
+  paintMinY = min(minY, boxMinY);
+  paintMaxX = max(maxX, boxMaxX);
+  paintMaxY = max(maxY, boxMaxY);
+  boxMinX = minX;
+  boxMinY = minY;
+  boxMaxX = maxX;
+  boxMaxY = maxY;
+#ifdef ENABLE_SPARSE_DIRTY
+  if (invalidFrames)
+    invalidFrames--;
+  if (++refreshBand > (paintMaxY - paintMinY - 1) >> SPARSE_REFRESH_BITS)
+    refreshBand = 0;
+#endif
+}
+
+void Invalidate()
+{
+  // the ship window has been painted over, so all of it must be painted next time
+  paintMinX = paintMinY = boxMinX = boxMinY = 0;
+  paintMaxX = paintMaxY = boxMaxX = boxMaxY = SHIP_WINDOW_SIZE;
+#ifdef ENABLE_SPARSE_DIRTY
+  invalidFrames = 2;  // the next frame is painted in full
+#endif
+}
+
 void Paint(int originX, int minRow, int maxRow, byte*& pRowStart)
 {
   // Paint the sparse pixels. Left edge is inset into window by originX.
-  // Rows painted are minRow..maxRow
+  // Rows painted are minRow..maxRow, within the bounding box
   // pRowStart optionally points to the start in the pool, updated to the end
-  LCD_BEGIN_FILL(SHIP_WINDOW_ORIGIN_X + originX, SHIP_WINDOW_ORIGIN_Y + minRow, SPARSE_COLS, maxRow - minRow);
+  int endRow = maxRow;
+  int clipMinCol, clipMaxCol;
+  if (!Clip(originX, minRow, maxRow, clipMinCol, clipMaxCol, pRowStart))
+    return;
+#ifdef ENABLE_SPARSE_DIRTY
+  int nextRow = -1, minCol = 0, maxCol = 0;   // the LCD window
+#else
+  int minCol = clipMinCol, maxCol = clipMaxCol;
+  LCD_BEGIN_FILL(SHIP_WINDOW_ORIGIN_X + originX + minCol, SHIP_WINDOW_ORIGIN_Y + minRow, maxCol - minCol, maxRow - minRow);
+#endif
   if (!pRowStart)
-    pRowStart = pool;
+    pRowStart = RowStart(minRow);
   byte* pRow = rows + minRow;
   for (int row = minRow; row < maxRow; row++, pRow++)
   {
+    SKIP_SLACK(row, pRowStart);
     byte* pValue = pRowStart;
     byte rowLen = *pRow;
     pRowStart += rowLen;
-    byte prevX = 0;
+#ifdef ENABLE_SPARSE_DIRTY
+    SKIP_CLEAN_ROW(originX, row, maxRow, pValue, rowLen, 0, clipMinCol, clipMaxCol, nextRow, minCol, maxCol);
+#endif
+    byte prevX = minCol;
     if (rowLen)
     {
       while (rowLen)
@@ -467,39 +604,81 @@ void Paint(int originX, int minRow, int maxRow, byte*& pRowStart)
         rowLen -= size;
         pValue += size;
       }
-      if (prevX < SPARSE_COLS)
-        LCD_FILL_BYTE(SPARSE_COLS - prevX, 0x00);
+      if (prevX < maxCol)
+        LCD_FILL_BYTE(maxCol - prevX, 0x00);
     }
     else
     {
       // blank row
-      LCD_FILL_BYTE(SPARSE_COLS, 0x00);
+      LCD_FILL_BYTE(maxCol - minCol, 0x00);
     }
   }
+  if (maxRow != endRow)
+    pRowStart = NULL; // not at the end
 }
 
-// convenience macros to "XOR" a sparse black or white pixel with the current raster pixel
-#define EOR_BLACK(_cols) while (_cols--) if (raster::Next()) LCD_ONE_WHITE(); else LCD_ONE_BLACK();
-#define EOR_WHITE(_cols) while (_cols--) if (raster::Next()) LCD_ONE_BLACK(); else LCD_ONE_WHITE();
+static void EOR(int cols, byte colour)
+{
+  // "XOR" cols sparse pixels, all black (0x00) or white (0xFF), with the raster pixels
+  // 8 at a time, each a run of the same pixels is a single fill
+  while (cols > 0)
+  {
+    byte count = (cols < 8) ? cols : 8;
+    cols -= count;
+    byte bits = raster::NextBits(count);
+    if (!bits)
+    {
+      // no text here
+      LCD_FILL_BYTE(count, colour);
+      continue;
+    }
+    bits ^= colour;
+    while (count)
+    {
+      byte first = bits & 0x80;
+      byte run = 0;
+      do
+      {
+        bits <<= 1;
+        run++;
+      } while (run < count && (bits & 0x80) == first);
+      LCD_FILL_BYTE(run, first ? 0xFF : 0x00);
+      count -= run;
+    }
+  }
+}
 
 void XORPaint(int originX, int minRow, int maxRow, byte textX, byte textY, const char* str, text::CharReader charLoader, byte*& pRowStart)
 {
   // As above, paints the sparse rows XOR'ed on-the-fly with the string, drawn at textX, textY
   int fillX = SHIP_WINDOW_ORIGIN_X + originX;
-  int fillY = SHIP_WINDOW_ORIGIN_Y + minRow;
+  int endRow = maxRow;
+  int clipMinCol = 0, clipMaxCol = SPARSE_COLS;
+  // text in RAM (the time) can change under the ship so is painted in full
+  if (charLoader == text::ProgMemCharReader && !Clip(originX, minRow, maxRow, clipMinCol, clipMaxCol, pRowStart))
+    return;
 
-  LCD_BEGIN_FILL(fillX, fillY, SPARSE_COLS, maxRow - minRow);
+#ifdef ENABLE_SPARSE_DIRTY
+  int nextRow = -1, minCol = 0, maxCol = 0;   // the LCD window
+  uint16_t textSignature = TextSignature(textX, textY, str, charLoader);
+#else
+  int minCol = clipMinCol, maxCol = clipMaxCol;
+  LCD_BEGIN_FILL(fillX + minCol, SHIP_WINDOW_ORIGIN_Y + minRow, maxCol - minCol, maxRow - minRow);
+#endif
   raster::Start(textX, textY, str, charLoader);
   if (!pRowStart)
-    pRowStart = pool;
+    pRowStart = RowStart(minRow);
   for (int row = minRow; row < maxRow; row++)
   {
+    SKIP_SLACK(row, pRowStart);
     byte* pValue = pRowStart;
     byte rowLen = rows[row];
     pRowStart += rowLen;
-    raster::Row(fillX, fillY++);
-    byte prevX = 0;
-    int cols;
+#ifdef ENABLE_SPARSE_DIRTY
+    SKIP_CLEAN_ROW(originX, row, maxRow, pValue, rowLen, textSignature, clipMinCol, clipMaxCol, nextRow, minCol, maxCol);
+#endif
+    raster::Row(fillX + minCol, SHIP_WINDOW_ORIGIN_Y + row);
+    byte prevX = minCol;
     if (rowLen)
     {
       while (rowLen)
@@ -509,33 +688,30 @@ void XORPaint(int originX, int minRow, int maxRow, byte textX, byte textY, const
         byte size = SPARSE_GET_SIZE(rowLen == 1, pValue);
         if (prevX < x)
         {
-          cols = x - prevX;
-          EOR_BLACK(cols);
+          EOR(x - prevX, 0x00);
           prevX = x + len;
-          EOR_WHITE(len);
+          EOR(len, 0xFF);
         }
         else if (prevX < x + len)
         {
           // deal with overlaps
           byte extra = x + len - prevX;
           prevX += extra;
-          EOR_WHITE(extra);
+          EOR(extra, 0xFF);
         }
         rowLen -= size;
         pValue += size;
       }
-      if (prevX < SPARSE_COLS)
-      {
-        cols = SPARSE_COLS - prevX;
-        EOR_BLACK(cols);
-      }
+      if (prevX < maxCol)
+        EOR(maxCol - prevX, 0x00);
     }
     else
     {
       // blank row
-      cols = SPARSE_COLS;
-      EOR_BLACK(cols);
+      EOR(maxCol - minCol, 0x00);
     }
   }
+  if (maxRow != endRow)
+    pRowStart = NULL; // not at the end
 }
 }
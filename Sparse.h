@@ -7,5 +7,8 @@ namespace sparse
   void Line(int x0, int y0, int x1, int y1, int minX, int maxX);
   void Paint(int originX, int minRow, int maxRow, byte*& pRowStart);
   void XORPaint(int originX, int minRow, int maxRow, byte textX, byte textY, const char* str, text::CharReader charLoader, byte*& pRowStart);
+  void Bounds(int minX, int minY, int maxX, int maxY);  // the extent of this frame's drawing, painting is limited to it & last frame's
+  void Invalidate();  // the ship window was drawn over, repaint it all next time
   extern uint16_t highWater;
+  extern uint32_t movedBytes; // bytes shuffled in the pool, for profiling (DEBUG, host & ENABLE_PROFILE builds only). Reset by the reader
 };
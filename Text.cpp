@@ -9,6 +9,19 @@ extern const byte Font[];  // forward
 char ProgMemCharReader(const char* a) { return pgm_read_byte(a); }
 char StdCharReader    (const char* a) { return *a; }
 
+static void FillRun(int run, bool on, word colour)
+{
+  // send run pixels of the text or the background
+  if (!run)
+    return;
+  if (!on)
+    LCD_FILL_BYTE(run, 0x00);
+  else if (colour)
+    LCD_FILL_COLOUR(run, colour);
+  else
+    LCD_FILL_BYTE(run, 0xFF);
+}
+
 void Draw(int x, int y, const char* str, CharReader charReader, word colour)
 {
   // Draw the string using the BBC font at {x, y} (which are LCD coordinates), using the reader to access the string
@@ -33,20 +46,44 @@ void Draw(int x, int y, const char* str, CharReader charReader, word colour)
   {
     raster::Row(x, y+row);
     int cols = 8*len;
-    if (italic && row < 4)
-      LCD_ONE_BLACK();
-      
-    while (cols--)
-      if (raster::Next())
-        if (colour)
-          LCD_FILL_COLOUR(1, colour);
-        else
-          LCD_ONE_WHITE();
-      else
-        LCD_ONE_BLACK();
-        
+    // the pixels are gathered into runs of the same colour, each is a single fill
+    bool on = false;
+    int run = (italic && row < 4) ? 1 : 0;  // italic rows start or end with a black pixel
+    while (cols)
+    {
+      byte count = (cols < 8) ? cols : 8;
+      cols -= count;
+      byte bits = raster::NextBits(count);
+      if (bits == (on ? (byte)(0xFF00 >> count) : 0x00))
+      {
+        // all the same as the run
+        run += count;
+        continue;
+      }
+      while (count--)
+      {
+        bool bit = bits & 0x80;
+        bits <<= 1;
+        if (bit != on)
+        {
+          FillRun(run, on, colour);
+          on = bit;
+          run = 0;
+        }
+        run++;
+      }
+    }
     if (italic && row >= 4)
-      LCD_ONE_BLACK();
+    {
+      if (on)
+      {
+        FillRun(run, on, colour);
+        on = false;
+        run = 0;
+      }
+      run++;
+    }
+    FillRun(run, on, colour);
   }
 }
 
@@ -86,8 +123,59 @@ byte _StrIdx = 0;
 text::CharReader _CharReader = NULL;
 int _LeadIn = 0;
 byte _CurrentChar = 0;
-byte _CurrentDefnByte = 0;
-byte _CurrentDefnMask = 0;
+byte _CurrentDefnByte = 0;  // the bits still to come, in the MSBs
+byte _BitsLeft = 0;         // how many
+
+#ifdef ENABLE_TEXT_CACHE
+/*
+  Rasterized strings.  The titles are XOR'd with the ship every frame but rarely change, the time once a minute.
+  So the font rows of a string's chars are fetched once, into a slot, and read from there.  A string is found by its
+  chars, so a changed one (the time, or the manual mode instructions) is simply another string.
+  When a string isn't found it replaces the least recently used.  Costs ~440 bytes RAM.
+*/
+#define RASTER_CACHE_SLOTS 2
+#define RASTER_CACHE_CHARS 24   // the longest title
+struct CacheSlot
+{
+  byte len;                             // 0 if unused
+  char chars[RASTER_CACHE_CHARS];
+  byte rows[8][RASTER_CACHE_CHARS];     // the font row of each char
+};
+CacheSlot cache[RASTER_CACHE_SLOTS];
+byte _LastSlot = 0;                     // the most recently used
+CacheSlot* _pSlot = NULL;               // the string being drawn, NULL if not cached
+
+static CacheSlot* Cached(const char* str, text::CharReader charReader)
+{
+  // find the string in the cache, or rasterize it into a slot.  NULL if it's too long
+  for (byte slot = 0; slot < RASTER_CACHE_SLOTS; slot++)
+  {
+    CacheSlot* pSlot = cache + slot;
+    byte idx = 0;
+    while (idx < pSlot->len && charReader(str + idx) == pSlot->chars[idx])
+      idx++;
+    if (pSlot->len && idx == pSlot->len && !charReader(str + idx))
+    {
+      _LastSlot = slot;
+      return pSlot;
+    }
+  }
+  size_t len = text::StrLen(str, charReader);
+  if (!len || len > RASTER_CACHE_CHARS)
+    return NULL;
+  _LastSlot = (_LastSlot + 1) % RASTER_CACHE_SLOTS;
+  CacheSlot* pSlot = cache + _LastSlot;
+  pSlot->len = len;
+  for (byte idx = 0; idx < len; idx++)
+  {
+    char ch = charReader(str + idx);
+    pSlot->chars[idx] = ch;
+    for (byte row = 0; row < 8; row++)
+      pSlot->rows[row][idx] = pgm_read_byte_near(text::Font + 8*(ch - ' ') + row);
+  }
+  return pSlot;
+}
+#endif
 
 void Start(int x, int y, const char* str, text::CharReader charReader)
 {
@@ -97,19 +185,40 @@ void Start(int x, int y, const char* str, text::CharReader charReader)
   _TextStr = str;
   _StrIdx = 0;
   _CharReader = charReader;
+#ifdef ENABLE_TEXT_CACHE
+  _pSlot = Cached(str, charReader);
+#endif
+}
+
+static void NextChar()
+{
+  // fetch the row of the next char, no bits left at the end of the string
+#ifdef ENABLE_TEXT_CACHE
+  if (_pSlot)
+  {
+    _CurrentChar = _CurrentChar && _StrIdx < _pSlot->len; // just "not the end"
+    _CurrentDefnByte = _CurrentChar?_pSlot->rows[_TextRow][_StrIdx++]:0x00;
+    _BitsLeft = _CurrentChar?8:0;
+    return;
+  }
+#endif
+  if (_CurrentChar)
+    _CurrentChar = _CharReader(_TextStr + _StrIdx++);
+  _CurrentDefnByte = _CurrentChar?pgm_read_byte_near(text::Font + 8*(_CurrentChar - ' ') + _TextRow):0x00;
+  _BitsLeft = _CurrentChar?8:0;
 }
 
 void Row(int x, int y)
 {
   // define the start of a row at x, y
   _TextRow = y - _TextY;
+  _LeadIn = 0;
+  _BitsLeft = 0;
+  _CurrentChar = 0;
   if (_TextRow < 0 || _TextRow > 7)
-  {
-    _LeadIn = 0xFFFF;  // all blank
-    return;
-  }
+    return; // all blank
   _StrIdx = 0;
-  _CurrentDefnMask = 0x80;
+  _CurrentChar = ' ';  // not the end
   int dX = x - _TextX;
   if (dX < 0)
   {
@@ -117,32 +226,56 @@ void Row(int x, int y)
   }
   else
   {
-    _LeadIn = 0;
-    _StrIdx = dX / 8;
-    _CurrentDefnMask >>= dX % 8;
+    // skip the chars before x, x may be past the end
+#ifdef ENABLE_TEXT_CACHE
+    if (_pSlot)
+    {
+      _StrIdx = min(dX / 8, _pSlot->len);
+      _CurrentChar = _StrIdx < _pSlot->len;
+      dX %= 8;
+    }
+#endif
+    for (; dX >= 8 && _CurrentChar; dX -= 8)
+      _CurrentChar = _CharReader(_TextStr + _StrIdx++);
+    if (dX && _CurrentChar)
+    {
+      NextChar();
+      _CurrentDefnByte <<= dX;
+      _BitsLeft = _CurrentChar?8 - dX:0;
+    }
   }
-  _CurrentChar = _CharReader(_TextStr + _StrIdx++);
-  _CurrentDefnByte = pgm_read_byte_near(text::Font + 8*(_CurrentChar - ' ') + _TextRow);
 }
 
-bool Next()
+byte NextBits(byte count)
 {
-  // return the next bit in the text row
-  bool result = false;
-  if (_LeadIn)  // before we get to the first char
-    _LeadIn--;
-  else if (_CurrentChar)
+  // return the next count (1..8) bits in the text row, the first in the MSB
+  byte bits = 0;
+  byte filled = 0;
+  if (_LeadIn)
   {
-    if (!_CurrentDefnMask)
+    if (_LeadIn >= count)
     {
-      _CurrentChar = _CharReader(_TextStr + _StrIdx++);
-      _CurrentDefnMask = 0x80;
-      _CurrentDefnByte = _CurrentChar?pgm_read_byte_near(text::Font + 8*(_CurrentChar - ' ') + _TextRow):0x00;
+      _LeadIn -= count;
+      return 0;
+    }
+    filled = _LeadIn;
+    _LeadIn = 0;
+  }
+  while (filled < count)
+  {
+    if (!_BitsLeft)
+    {
+      NextChar();
+      if (!_BitsLeft)
+        break;
     }
-    result = _CurrentDefnByte & _CurrentDefnMask;
-    _CurrentDefnMask >>= 1;
+    bits |= _CurrentDefnByte >> filled;
+    byte used = min(count - filled, _BitsLeft);
+    _CurrentDefnByte <<= used;
+    _BitsLeft -= used;
+    filled += used;
   }
-  return result;
+  return bits & (0xFF00 >> count);
 }
 } // namespace raster
 
@@ -31,5 +31,5 @@ namespace raster
 {
   void Start(int x, int y, const char* str, text::CharReader charReader = text::ProgMemCharReader);
   void Row(int x, int y);
-  bool Next();
+  byte NextBits(byte count);  // 1..8 bits at once, the first in the MSB
 };
@@ -0,0 +1,57 @@
+#include <Arduino.h>
+#include "Timer.h"
+
+// A handful of one-shot timers, see Timer.h
+
+namespace timer {
+// the startup sequence, the frame & the ship label, with room to spare
+#define TIMER_SLOTS 4
+
+struct Slot
+{
+  Task task;          // NULL if free
+  unsigned long dueMS;
+};
+Slot slots[TIMER_SLOTS];
+
+void After(unsigned long ms, Task task)
+{
+  Slot* pFree = NULL;
+  for (Slot* pSlot = slots; pSlot < slots + TIMER_SLOTS; pSlot++)
+  {
+    if (pSlot->task == task)
+    {
+      pFree = pSlot;
+      break;
+    }
+    if (!pSlot->task && !pFree)
+      pFree = pSlot;
+  }
+  if (!pFree)
+    return; // full, TIMER_SLOTS is too small
+  pFree->task = task;
+  pFree->dueMS = millis() + ms;
+}
+
+void Cancel(Task task)
+{
+  for (Slot* pSlot = slots; pSlot < slots + TIMER_SLOTS; pSlot++)
+    if (pSlot->task == task)
+      pSlot->task = NULL;
+}
+
+void Run()
+{
+  unsigned long nowMS = millis();
+  for (Slot* pSlot = slots; pSlot < slots + TIMER_SLOTS; pSlot++)
+  {
+    Task task = pSlot->task;
+    if (task && (long)(nowMS - pSlot->dueMS) >= 0)
+    {
+      // free the slot first, the task may schedule itself again
+      pSlot->task = NULL;
+      task();
+    }
+  }
+}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+// Cooperative timers, instead of delay()
+// A task is a plain function run once, some ms from now, by Run() which loop() calls every time round.
+// Tasks run to completion and mustn't block; a task that wants to repeat schedules itself again
+namespace timer
+{
+  typedef void (*Task)();
+
+  void After(unsigned long ms, Task task);  // run task once, ms from now. Replaces a pending run of the same task
+  void Cancel(Task task);
+  void Run();                               // runs the tasks that are due
+};
@@ -1,6 +1,5 @@
 #include <Arduino.h>
 #include "RTC.h"
-#include "BTN.h"
 #include "Elite.h"
 #include "Dials.h"
 #include "Text.h"
@@ -9,10 +8,14 @@
 #include "Ship.h"
 #include "Config.h"
 #include "View.h"
+#include "Profile.h"
+#include "Input.h"
+#include "Timer.h"
 
 #ifdef DEBUG
 unsigned long sumLinesMS = 0;
 unsigned long sumPaintMS = 0;
+unsigned long sumTransformUS = 0;
 #endif
 
 #ifdef DEBUG_STACK_CHECK
@@ -45,11 +48,12 @@ static const char pManual[] PROGMEM = "   Drag to pitch & roll ";
 char pTimeTitle[21];  // "---- H H : M M ----";
 
 bool manualMode = false;  // manually pitching & rolling
+bool statusDrawn = false; // the status screen is on the LCD, see DrawStatus()
 
 void GetTimeStr(char* Buffer)
 {
   // puts HHMM into buffer, 12 or 24-hour format
-  rtc.ReadTime();
+  rtc.Now();
   if (config::data.m_b24HourTime)
   {
     Buffer[0] = '0' + (rtc.m_Hour24 / 10);
@@ -127,6 +131,9 @@ const char* GetTextLine(int item, int& x, int& y, text::CharReader& charReader)
 void DrawTextLines()
 {
   // draws the 3 pieces of text
+  // the ship is XOR'd with the text and anything drawn over the ship window is followed by this, so repaint all of it
+  sparse::Invalidate();
+  statusDrawn = false;
   if (config::data.m_bShowLoadScreen)  
     for (int item = 0; item < 3; item++)
     {
@@ -150,11 +157,34 @@ int16_t maxShipScale = 64;
 int16_t currentShipScale = 64;
 // Flash the name of the ship?
 bool labelShip = false;
+// The name while it's up, XOR'd with the ship like the text lines
+const char* pLabel = NULL;
+int labelX, labelY;
+void HideLabel();
 // The current ship
 ship::Details currentShip;
 ship::Type currentShipType = ship::CobraMk3;
 int16_t frameCount = 0;
 
+#ifdef ENABLE_TIMED_ANIMATION
+// The steps above are per ANIMATION_STEP_MS, the ~10Hz frame they were tuned for
+#define ANIMATION_STEP_MS 100
+// A longer gap (the menu, manual mode) counts as this, the ship doesn't lurch
+#define ANIMATION_MAX_MS  200
+unsigned long animationMS = 0;  // time of the last step
+// the part-steps carried to the next frame, in step*ms
+int16_t approachRemainder = 0, rollRemainder = 0, pitchRemainder = 0;
+
+int16_t TimedStep(int16_t& remainder, int16_t step, int16_t elapsedMS)
+{
+  // step scaled from ANIMATION_STEP_MS to elapsedMS, carrying what's left over
+  remainder += step * elapsedMS;
+  int16_t timedStep = remainder / ANIMATION_STEP_MS;
+  remainder -= timedStep * ANIMATION_STEP_MS;
+  return timedStep;
+}
+#endif
+
 int16_t randomStepDegrees()
 {
   // returns a number -maxStepDegrees ... +maxStepDegrees (excluding 0)
@@ -310,6 +340,7 @@ void Init()
   dials::Draw(true);
   LoadShip(true, false);
   labelShip = false;
+  HideLabel();
   DrawTextLines();
 }
 
@@ -351,6 +382,10 @@ void LoadShip(bool animateApproach, bool label)
 #endif  
 }
 
+// Rotations
+// We rotate about the view's Z axis (roll) and X axis (pitch). There is no yaw (Y).
+
+#ifndef ENABLE_ROTATION_MATRIX
 static int64_t NORM(int64_t a)
 {
   // normalize numerators, basically multiply by denominator
@@ -380,9 +415,6 @@ static int16_t CONV(int64_t a, int16_t n, int16_t scale)
   return (int16_t)div;
 }
 
-// Rotations
-// We rotate about the view's Z axis (roll) and X axis (pitch). There is no yaw (Y).
-
 // Just returns the UNSCALED rotated Z
 static int64_t RotateZ(int16_t x, int16_t y, int16_t z, int16_t rollDeg, int16_t pitchDeg)
 {
@@ -409,6 +441,90 @@ static void RotateXY(int16_t& x, int16_t& y, int16_t z, int16_t rollDeg, int16_t
   y = CONV(Y, 2, currentShipScale);
 }
 
+#else
+// The same rotations as a 3x3 matrix, built once for each roll, pitch & scale (i.e. once per frame), then applied to each
+// face & vertex with 16x16->32-bit multiplies, rather than the 64-bit multiplies above.
+// The entries are fractions, the numerator over 2^MATRIX_FRACTION_BITS. The X & Y rows are premultiplied by the scale,
+// so the entries are < 2 while the scale is < 512 (the largest blueprint scale is ~420).
+// The 8-bit trig values have already rounded things, the 14-bit entries add at most 1/40th of a pixel for the largest ship.
+// So it's not bit-identical to the above: a coordinate within that of a .5 can round the other way, 1 pixel out, and a
+// face seen exactly edge-on can flip. Both are below what the 8-bit trig already gets wrong, and move frame to frame anyway.
+#define MATRIX_FRACTION_BITS 14
+
+struct Rotation
+{
+  int16_t rollDeg, pitchDeg, scale;   // what the matrix was built for
+  int16_t xx, xy;                     // X row, there's no z term
+  int16_t yx, yy, yz;                 // Y row
+  int16_t zx, zy, zz;                 // Z row, unscaled, just used for the sign
+};
+
+static Rotation rotation = {-1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+static int16_t MatrixFraction(int32_t numerator, int16_t bits)
+{
+  // numerator over 2^bits as a matrix entry, rounded
+  int16_t shift = bits - MATRIX_FRACTION_BITS;
+  if (numerator >= 0)
+    return (numerator + (1L << (shift - 1))) >> shift;
+  else
+    return -((-numerator + (1L << (shift - 1))) >> shift);   // shifting -ve values is undefined
+}
+
+static void BuildRotation(int16_t rollDeg, int16_t pitchDeg)
+{
+  // The matrix multiplication terms from RotateZ & RotateXY above
+  int32_t cosRoll  = COS_TABLE(rollDeg),  sinRoll  = SIN_TABLE(rollDeg);
+  int32_t cosPitch = COS_TABLE(pitchDeg), sinPitch = SIN_TABLE(pitchDeg);
+  int32_t scale = currentShipScale;
+  const int16_t bits1 = TRIG_FRACTION_BITS + SCALE_FRACTION_BITS;
+  const int16_t bits2 = 2 * TRIG_FRACTION_BITS + SCALE_FRACTION_BITS;
+  rotation.xx = MatrixFraction(cosRoll * scale, bits1);
+  rotation.xy = MatrixFraction(sinRoll * scale, bits1);
+  rotation.yx = MatrixFraction(-sinRoll * cosPitch * scale, bits2);
+  rotation.yy = MatrixFraction(cosRoll * cosPitch * scale, bits2);
+  rotation.yz = MatrixFraction(sinPitch * scale, bits1);
+  rotation.zx = MatrixFraction(sinRoll * sinPitch, 2 * TRIG_FRACTION_BITS);
+  rotation.zy = MatrixFraction(-cosRoll * sinPitch, 2 * TRIG_FRACTION_BITS);
+  rotation.zz = cosPitch * (1 << (MATRIX_FRACTION_BITS - TRIG_FRACTION_BITS));
+  rotation.rollDeg = rollDeg;
+  rotation.pitchDeg = pitchDeg;
+  rotation.scale = currentShipScale;
+}
+
+static void CheckRotation(int16_t rollDeg, int16_t pitchDeg)
+{
+  // (re)build the matrix if the orientation or scale has changed
+  if (rollDeg != rotation.rollDeg || pitchDeg != rotation.pitchDeg || currentShipScale != rotation.scale)
+    BuildRotation(rollDeg, pitchDeg);
+}
+
+static int16_t MatrixRound(int32_t a)
+{
+  // a fraction over 2^MATRIX_FRACTION_BITS to the nearest integer, rounding halves away from 0 like CONV
+  if (a >= 0)
+    return (a + (1L << (MATRIX_FRACTION_BITS - 1))) >> MATRIX_FRACTION_BITS;
+  else
+    return -((-a + (1L << (MATRIX_FRACTION_BITS - 1))) >> MATRIX_FRACTION_BITS);
+}
+
+// Just returns the UNSCALED rotated Z, a fraction. Only the sign is used.
+static int32_t RotateZ(int16_t x, int16_t y, int16_t z, int16_t rollDeg, int16_t pitchDeg)
+{
+  CheckRotation(rollDeg, pitchDeg);
+  return (int32_t)rotation.zx * x + (int32_t)rotation.zy * y + (int32_t)rotation.zz * z;
+}
+
+// Just updates the x & y with rotated & scaled values
+static void RotateXY(int16_t& x, int16_t& y, int16_t z, int16_t rollDeg, int16_t pitchDeg)
+{
+  CheckRotation(rollDeg, pitchDeg);
+  int32_t X = (int32_t)rotation.xx * x + (int32_t)rotation.xy * y;
+  int32_t Y = (int32_t)rotation.yx * x + (int32_t)rotation.yy * y + (int32_t)rotation.yz * z;
+  x = MatrixRound(X);
+  y = MatrixRound(Y);
+}
+#endif
 
 void NormalizeAngle(int16_t& angle)
 {
@@ -449,7 +565,8 @@ void DrawClockFace(int minX, int maxX)
   // draw the symthetic "edges" on the clock ship that show the time
   ship::Vertex org;
   char strTime[4];
-  bool dotOn = rtc.ReadSecond() % 2;
+  rtc.Now();
+  bool dotOn = rtc.m_Second % 2;
   GetTimeStr(strTime);
   memcpy_P(&org,  currentShip.vertices, sizeof(ship::Vertex));
   org.x += CLOCK_SHIP_DIGIT_X;
@@ -523,9 +640,22 @@ static const char statusText[] PROGMEM =
      //TEXT_MSTR("Right Beam Laser")
 ;
 
+// The status screen doesn't change, apart from the time in the title.  So it's drawn in full once, then only
+// the title line is redrawn, when the minute changes or the title is toggled.  DrawTextLines() forces it all again
+int8_t statusMinute = -1; // the minute in the title, -1 for COMMANDER
+
 void DrawStatus()
 {
-  // draw the status text screen
+  // draw the status text screen, or what's changed
+  int8_t minute = -1;
+  if (config::data.m_bTimeTitle)
+  {
+    rtc.Now();
+    minute = rtc.m_Minute;
+  }
+  if (statusDrawn && minute == statusMinute)
+    return;
+  statusMinute = minute;
   const char* pLine = statusText;
   int textRow = 0;
   while (pgm_read_byte(pLine))
@@ -540,10 +670,13 @@ void DrawStatus()
     }
     else if (pgm_read_byte(pLine) != '\n')
       text::Draw((textRow > 11)?SCREEN_OFFSET_X + 6*TEXT_SIZE:SCREEN_OFFSET_X + TEXT_SIZE, TEXT_SIZE + TEXT_SIZE*textRow, pLine);
+    if (statusDrawn)
+      return; // just the title
     pLine += text::StrLen(pLine) + 1;
     textRow++;
   }
   LCD_FILL_BYTE(LCD_BEGIN_FILL(SCREEN_OFFSET_X, SCREEN_OFFSET_Y + 19, SPACE_WIDTH, 1), 0xFF);
+  statusDrawn = true;
 }
 
 void Loop()
@@ -558,9 +691,46 @@ void Loop()
 #endif  
 }
 
+// The frame governor, holds frames to config::data.targetFramePeriodMS by shedding detail
+// Level 0 is full detail, each level up sheds more:
+//   the approach takes bigger steps, over in fewer (radar-redrawing) frames
+//   the ship loses detail lines, see MinVisibility() (with ENABLE_SHIP_LOD)
+#define GOVERNOR_MAX_LEVEL   2
+#define GOVERNOR_HOLD_FRAMES 8  // after a change, let the average settle
+byte governorLevel = 0;
+#ifdef ENABLE_SHIP_LOD
+// Blueprint visibility culled per unit of distance, per governor level
+#define VISIBILITY_PER_DISTANCE 4
+#define VISIBILITY_PER_LEVEL    8
+#endif
+byte governorHold = 0;
+uint16_t frameCostMS4 = 0;      // running average of the frame cost, x4
+
+void Govern(unsigned long costMS)
+{
+  // move governorLevel up if frames cost more than the target, down when there's room again
+  unsigned long targetMS = config::data.targetFramePeriodMS;
+  if (!targetMS)
+    return;
+  frameCostMS4 += min(costMS, 1000UL) - frameCostMS4 / 4;
+  if (governorHold)
+    governorHold--;
+  else if (frameCostMS4 > 4 * targetMS && governorLevel < GOVERNOR_MAX_LEVEL)
+  {
+    governorLevel++;
+    governorHold = GOVERNOR_HOLD_FRAMES;
+  }
+  else if (frameCostMS4 < 3 * targetMS && governorLevel > 0)
+  {
+    governorLevel--;
+    governorHold = GOVERNOR_HOLD_FRAMES;
+  }
+}
+
 void AnimateShip()
 {
   // draw a frame of the ship animation
+  unsigned long startMS = millis();
   frameCount++;
   if (frameCount > 1000)
   {
@@ -574,14 +744,41 @@ void AnimateShip()
 
   if (currentShipScale < maxShipScale)
   {
+    PROFILE_START(RadarUpdate);
     dials::UpdateRadar(currentShipScale, maxShipScale);
+    PROFILE_STOP(RadarUpdate);
+  }
+
+  if (labelShip)
+  {
+    // show the ship's name for a second, it tumbles on behind it (see DrawShip())
+    HideLabel();
+    pLabel = text::StrN(ship::NameMultiStr_PGM, currentShipType);
+    labelX = (LCD_WIDTH - strlen_P(pLabel)*TEXT_SIZE)/2;
+    labelY = SHIP_WINDOW_ORIGIN_Y + (SHIP_WINDOW_SIZE - TEXT_SIZE)/2;
+    text::Draw(labelX, labelY, pLabel);
+    timer::After(1000, HideLabel);
+    labelShip = false;
   }
 
   DrawShip();
 
+  Govern(millis() - startMS);
+
+  int16_t approachStep = 2 << governorLevel, rollStep = rollStepDegrees, pitchStep = pitchStepDegrees;
+#ifdef ENABLE_TIMED_ANIMATION
+  // steps in proportion to the time since the last frame, a slow frame takes bigger steps
+  unsigned long nowMS = millis();
+  int16_t elapsedMS = min(nowMS - animationMS, (unsigned long)ANIMATION_MAX_MS);
+  animationMS = nowMS;
+  approachStep = TimedStep(approachRemainder, approachStep, elapsedMS);
+  rollStep     = TimedStep(rollRemainder,     rollStep,     elapsedMS);
+  pitchStep    = TimedStep(pitchRemainder,    pitchStep,    elapsedMS);
+#endif
+
   if (currentShipScale < maxShipScale)
   {
-    currentShipScale += 2;
+    currentShipScale += approachStep;
     if (currentShipScale >= maxShipScale)
     {
       dials::UpdateRadar(0, 0);  // remove it?
@@ -589,21 +786,35 @@ void AnimateShip()
     }
   }
 
-  rollDegrees += rollStepDegrees;
-  pitchDegrees += pitchStepDegrees;
+  rollDegrees += rollStep;
+  pitchDegrees += pitchStep;
+}
 
-  if (labelShip)
+void HideLabel()
+{
+  // take the ship's name down, a timer task (see AnimateShip())
+  if (!pLabel)
+    return;
+  if (config::data.m_bShowLoadScreen && elite::Running())
   {
-    const char* pShipName = text::StrN(ship::NameMultiStr_PGM, currentShipType);
-    int len = strlen_P(pShipName);
-    const int margin = TEXT_SIZE/2;
-    int x = (LCD_WIDTH - len*TEXT_SIZE)/2;
-    int y = SHIP_WINDOW_ORIGIN_Y + (SHIP_WINDOW_SIZE - TEXT_SIZE)/2;
-    LCD_FILL_BYTE(LCD_BEGIN_FILL(x - margin, y - margin, len*TEXT_SIZE + 2*margin, TEXT_SIZE + 2*margin), 0x00);
-    text::Draw(x, y, pShipName);
-    delay(1000);
-    labelShip = false;
+    LCD_FILL_BYTE(LCD_BEGIN_FILL(labelX, labelY, strlen_P(pLabel)*TEXT_SIZE, TEXT_SIZE), 0x00);
+    sparse::Invalidate();
   }
+  pLabel = NULL;
+  timer::Cancel(HideLabel);
+}
+
+byte MinVisibility()
+{
+  // The blueprint visibility an edge or vertex needs to be drawn, 0 draws everything
+  // As in Elite, detail goes when the ship's distant. Here distance is 1/scale, 1 when it fills the window
+  // The governor sheds more detail from slow frames
+  byte minVisibility = 0;
+#ifdef ENABLE_SHIP_LOD
+  minVisibility = min(VISIBILITY_PER_DISTANCE * (maxShipScale - currentShipScale) / currentShipScale, 31);
+  minVisibility = min(minVisibility + VISIBILITY_PER_LEVEL * governorLevel, 31);
+#endif
+  return minVisibility;
 }
 
 void DrawShip()
@@ -611,6 +822,49 @@ void DrawShip()
   // Does the work of drawing the ship
   NormalizeAngle(rollDegrees);
   NormalizeAngle(pitchDegrees);
+#ifdef DEBUG
+  unsigned long nowUS = micros();
+#endif    
+  // the 3D work is done once per frame, even when the ship is painted in two passes
+  PROFILE_START(FaceVisibility);
+  uint16_t visibleFaces = 0;
+  const Face* pNormal = viewFaces;
+  // build a bitset of the faces that are visible, those with a +ve normal
+  for (size_t faceIdx = 0; faceIdx < currentShip.numFaces; faceIdx++, pNormal++)
+  {
+    if (RotateZ(pNormal->normal_x, pNormal->normal_y, pNormal->normal_z, rollDegrees, pitchDegrees) > 0LL)
+      visibleFaces |= 1 << faceIdx;
+  }
+  PROFILE_STOP(FaceVisibility);
+  byte minVisibility = MinVisibility();
+  // transform just the visible vertices! And find their extent
+  PROFILE_START(VertexTransform);
+  int left = SHIP_WINDOW_SIZE, top = SHIP_WINDOW_SIZE, right = -1, bottom = -1;
+  const ship::Vertex* pVertex = currentShip.vertices;
+  Coords* pCoord = m_transformedCoords;
+  for (size_t vertexIdx = 0; vertexIdx < currentShip.numVertices; vertexIdx++, pVertex++, pCoord++)
+  {
+    ship::Vertex vertex;
+    memcpy_P(&vertex, pVertex, sizeof(ship::Vertex));
+    if ((vertex.faces & visibleFaces) && vertex.visibility >= minVisibility)
+    {
+      int16_t x = vertex.x, y = vertex.y;
+      RotateXY(x, y, vertex.z, rollDegrees, pitchDegrees);
+      pCoord->x = SHIP_WINDOW_SIZE / 2 + x;
+      pCoord->y = SHIP_WINDOW_SIZE / 2 - y;
+      left   = min(left,   pCoord->x);
+      right  = max(right,  pCoord->x);
+      top    = min(top,    pCoord->y);
+      bottom = max(bottom, pCoord->y);
+    }
+  }
+  // only the part of the window the ship is in, or was last frame, is painted
+  sparse::Bounds(left, top, right, bottom);
+  PROFILE_STOP(VertexTransform);
+#ifdef DEBUG
+  sumTransformUS += micros() - nowUS;
+#endif
+
 #ifdef ENABLE_SPARSE_WIDE
   const int minX = 0, maxX = SHIP_WINDOW_SIZE;
   {
@@ -618,6 +872,7 @@ void DrawShip()
     unsigned long nowMS = millis();
 #endif    
 #else
+  // just the sparse lines & painting are repeated for each half
   int minX = 0, maxX = SHIP_WINDOW_SIZE / 2;
   for (int pass = 0; pass < 2; pass++)
   {
@@ -630,29 +885,8 @@ void DrawShip()
       maxX = SHIP_WINDOW_SIZE;
     }
 #endif    
+    PROFILE_START(LineRasterize);
     sparse::Clear();
-    uint16_t visibleFaces = 0;
-    const Face* pNormal = viewFaces;
-    // build a bitset of the faces that are visible, those with a +ve normal
-    for (size_t faceIdx = 0; faceIdx < currentShip.numFaces; faceIdx++, pNormal++)
-    {
-      if (RotateZ(pNormal->normal_x, pNormal->normal_y, pNormal->normal_z, rollDegrees, pitchDegrees) > 0LL)
-        visibleFaces |= 1 << faceIdx;
-    }
-    // transform just the visible vertices!
-    const ship::Vertex* pVertex = currentShip.vertices;
-    Coords* pCoord = m_transformedCoords;
-    for (size_t vertexIdx = 0; vertexIdx < currentShip.numVertices; vertexIdx++, pVertex++, pCoord++)
-    {
-      ship::Vertex vertex;
-      memcpy_P(&vertex, pVertex, sizeof(ship::Vertex));
-      if (vertex.faces & visibleFaces)
-      {
-        RotateXY(vertex.x, vertex.y, vertex.z, rollDegrees, pitchDegrees);
-        pCoord->x = SHIP_WINDOW_SIZE / 2 + vertex.x;
-        pCoord->y = SHIP_WINDOW_SIZE / 2 - vertex.y;
-      }
-    }
 
     const ship::Edge* pEdge = currentShip.edges;
     // draw the visible edges
@@ -660,7 +894,7 @@ void DrawShip()
     {
       ship::Edge edge;
       memcpy_P(&edge, pEdge, sizeof(ship::Edge));
-      if ((visibleFaces & (1 << edge.face1)) || (visibleFaces & (1 << edge.face2)))
+      if (((visibleFaces & (1 << edge.face1)) || (visibleFaces & (1 << edge.face2))) && edge.visibility >= minVisibility)
       {
         sparse::Line(m_transformedCoords[edge.vertex1].x, m_transformedCoords[edge.vertex1].y, m_transformedCoords[edge.vertex2].x, m_transformedCoords[edge.vertex2].y, minX, maxX);
       }
@@ -670,6 +904,7 @@ void DrawShip()
     if (currentShipType == ship::Clock && visibleFaces & 1)
       DrawClockFace(minX, maxX);
 #endif      
+    PROFILE_STOP(LineRasterize);
 #ifdef DEBUG
     unsigned long durationMS = millis() - nowMS;
     sumLinesMS += durationMS;
@@ -682,13 +917,29 @@ void DrawShip()
     text::CharReader charReader;
     // XOR-paintt the upper rows
     const char* pStr = GetTextLine(0, textX, textY, charReader);  // ELITE
+    PROFILE_START(XORPaint);
     sparse::XORPaint(minX, 0, TEXT_SIZE, textX, textY, pStr, charReader, pRowStart);
+    PROFILE_STOP(XORPaint);
     pStr = GetTextLine(1, textX, textY, charReader);   // Load
     int LoadRow = textY - SHIP_WINDOW_ORIGIN_Y;
-    // paint the middle part
-    sparse::Paint(minX, TEXT_SIZE, LoadRow, pRowStart);
+    // paint the middle part, XOR'd with the ship's name when it's up
+    int labelRow = pLabel ? labelY - SHIP_WINDOW_ORIGIN_Y : LoadRow;
+    PROFILE_START(Paint);
+    sparse::Paint(minX, TEXT_SIZE, labelRow, pRowStart);
+    PROFILE_STOP(Paint);
+    if (pLabel)
+    {
+      PROFILE_START(XORPaint);
+      sparse::XORPaint(minX, labelRow, labelRow + TEXT_SIZE, labelX, labelY, pLabel, text::ProgMemCharReader, pRowStart);
+      PROFILE_STOP(XORPaint);
+      PROFILE_START(Paint);
+      sparse::Paint(minX, labelRow + TEXT_SIZE, LoadRow, pRowStart);
+      PROFILE_STOP(Paint);
+    }
     // XOR-paint the lower rows
+    PROFILE_START(XORPaint);
     sparse::XORPaint(minX, LoadRow, SHIP_WINDOW_SIZE, textX, textY, pStr, charReader, pRowStart);
+    PROFILE_STOP(XORPaint);
     
 #ifdef DEBUG
     durationMS = millis() - nowMS;
@@ -701,6 +952,7 @@ void ManualMode(int holdX, int holdY)
 {
   // drag on the touch screen to pitch & roll
   manualMode = true;
+  HideLabel();  // timers don't run in here, so it would stay up
   DrawTextLines();
   currentShipScale = maxShipScale;
   int prevX = holdX, prevY = holdY;
@@ -718,65 +970,57 @@ void ManualMode(int holdX, int holdY)
   GetTextLine(1, textX, loadY, charReader);
   while (true)
   {
-    if (dragging)
+    input::Poll();
+    if (input::touch == input::Drag && dragging)
     {
-      int thisX, thisY;
-      if (LCD_GET_TOUCH(thisX, thisY))
+      // pitch & roll by how far it's been dragged
+      int16_t delta_RollDegrees = (prevX - input::touchX) / 2, delta_PitchDegrees = (prevY - input::touchY) / 2;
+      bool draw = false;
+      if (delta_RollDegrees)
       {
-        // drag
-        int16_t delta_RollDegrees = (prevX - thisX) / 2, delta_PitchDegrees = (prevY - thisY) / 2;
-        bool draw = false;
-        if (delta_RollDegrees)
-        {
-          rollDegrees  = start_RollDegrees  + delta_RollDegrees;
-          draw = true;
-        }
-        if (delta_PitchDegrees)
-        {
-          pitchDegrees = start_PitchDegrees + delta_PitchDegrees;
-          draw = true;
-        }
-        if (draw)
-          DrawShip();
+        rollDegrees  = start_RollDegrees  + delta_RollDegrees;
+        draw = true;
       }
-      else
+      if (delta_PitchDegrees)
       {
-        // release
-        if (!firstDrag && millis() - dragStartMS < 100)
-        {
-          // tap -- exit
-          break;
-        }
-        idleStartMS = millis();
-        dragging = false;
+        pitchDegrees = start_PitchDegrees + delta_PitchDegrees;
+        draw = true;
       }
+      if (draw)
+        DrawShip();
     }
-    else
+    else if (input::touch == input::Release)
     {
-      if (LCD_GET_TOUCH(prevX, prevY))
+      if (!firstDrag && millis() - dragStartMS < 100)
       {
-        if (prevX > SCREEN_OFFSET_X && prevX < (SCREEN_OFFSET_X + SCREEN_WIDTH) && prevY > eliteY && prevY < loadY)
-        {
-          // touch inside extended ship area
-          dragging = true;
-          start_RollDegrees = rollDegrees;
-          start_PitchDegrees = pitchDegrees;
-          dragStartMS = millis();
-          firstDrag = false;
-        }
-        else
-          break;
+        // tap -- exit
+        break;
       }
-      else
+      idleStartMS = millis();
+      dragging = false;
+    }
+    else if (input::touch == input::Press)
+    {
+      prevX = input::touchX;
+      prevY = input::touchY;
+      if (prevX > SCREEN_OFFSET_X && prevX < (SCREEN_OFFSET_X + SCREEN_WIDTH) && prevY > eliteY && prevY < loadY)
       {
-        if (millis() - idleStartMS > 20000)
-        {
-          break;
-        }
+        // touch inside extended ship area
+        dragging = true;
+        start_RollDegrees = rollDegrees;
+        start_PitchDegrees = pitchDegrees;
+        dragStartMS = millis();
+        firstDrag = false;
       }
+      else
+        break;
+    }
+    else if (!dragging && millis() - idleStartMS > 20000)
+    {
+      break;
     }
 
-    if (btn1Set.CheckButtonPress() || btn2Adj.CheckButtonPress())
+    if (input::btnSet == input::Press || input::btnAdj == input::Press)
       break;
   }
 
@@ -0,0 +1,75 @@
+#pragma once
+
+// Just enough of the Arduino core to build ElitePetite on a workstation.
+// PROGMEM is ordinary memory, pins float high, the clock is simulated (see Host.cpp).
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+
+typedef uint8_t byte;
+typedef uint16_t word;
+typedef bool boolean;
+
+// Program memory
+#define PROGMEM
+#define pgm_read_byte(_a)       (*(const uint8_t*)(_a))
+#define pgm_read_word(_a)       (*(const uint16_t*)(_a))
+#define pgm_read_dword(_a)      (*(const uint32_t*)(_a))
+#define pgm_read_byte_near(_a)  pgm_read_byte(_a)
+#define pgm_read_word_near(_a)  pgm_read_word(_a)
+#define memcpy_P  memcpy
+#define strcpy_P  strcpy
+#define strlen_P  strlen
+
+// Pins
+#define LOW  0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+
+// Time, simulated.  Advanced by delay(), by LCD bus traffic and by a microsecond per millis() call (so busy-waits end)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void hostAdvanceNS(uint64_t ns);
+
+// Deterministic PRNG
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// Serial goes to stderr
+class HardwareSerial
+{
+  public:
+    void begin(unsigned long) {}
+    void print(const char* s)   { fputs(s, stderr); }
+    void print(char c)          { fputc(c, stderr); }
+    void print(int n)           { fprintf(stderr, "%d", n); }
+    void print(unsigned n)      { fprintf(stderr, "%u", n); }
+    void print(long n)          { fprintf(stderr, "%ld", n); }
+    void print(unsigned long n) { fprintf(stderr, "%lu", n); }
+    void write(const uint8_t* data, size_t len) { fwrite(data, 1, len, stderr); }
+    void write(uint8_t b)       { fputc(b, stderr); }
+    template<typename T> void println(T t) { print(t); println(); }
+    void println()              { fputc('\n', stderr); }
+};
+extern HardwareSerial Serial;
+
+// After the system headers, as on the AVR core
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define abs(x) ((x)>0?(x):-(x))
@@ -0,0 +1,15 @@
+#pragma once
+
+// Host EEPROM, 1k of RAM, erased (0xFF) at start-up so the defaults are saved
+class EEPROMClass
+{
+  public:
+    EEPROMClass() { memset(m_Data, 0xFF, sizeof(m_Data)); }
+    uint8_t read(int addr) { return m_Data[addr]; }
+    void write(int addr, uint8_t value) { m_Data[addr] = value; }
+    
+  private:
+    uint8_t m_Data[1024];
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <Arduino.h>
+#include "FrameBuffer.h"
+
+FrameBuffer fb;
+
+void FrameBuffer::init()
+{
+  memset(m_Pixel, 0, sizeof(m_Pixel));
+  ResetCounts();
+}
+
+void FrameBuffer::Strobe(uint32_t count)
+{
+  m_Strobes += count;
+  hostAdvanceNS((uint64_t)count * FB_NS_PER_STROBE);
+}
+
+unsigned long FrameBuffer::beginFill(int x, int y, int w, int h)
+{
+  m_X = x;
+  m_Y = y;
+  m_W = w;
+  m_H = h;
+  m_Cursor = 0;
+  m_Windows++;
+  Strobe(FB_WINDOW_STROBES);
+  unsigned long count = w;
+  count *= h;
+  return count;
+}
+
+void FrameBuffer::Put(word colour)
+{
+  // write at the cursor, wrapping within the window, clipped to the panel
+  if (m_W <= 0 || m_H <= 0)
+    return;
+  int x = m_X + (int)(m_Cursor % m_W);
+  int y = m_Y + (int)((m_Cursor / m_W) % m_H);
+  if (0 <= x && x < FB_WIDTH && 0 <= y && y < FB_HEIGHT)
+    m_Pixel[y][x] = colour;
+  m_Cursor++;
+}
+
+void FrameBuffer::fillColour(unsigned long count, word colour)
+{
+  m_Pixels += count;
+  Strobe(2 * count);
+  while (count--)
+    Put(colour);
+}
+
+void FrameBuffer::fillByte(unsigned long count, byte colour)
+{
+  fillColour(count, (colour << 8) | colour);
+}
+
+void FrameBuffer::OneWhite()
+{
+  fillColour(1, 0xFFFF);
+}
+
+void FrameBuffer::OneBlack()
+{
+  fillColour(1, 0x0000);
+}
+
+bool FrameBuffer::getTouch(int& x, int& y)
+{
+  // no touch screen on the host
+  (void)x;
+  (void)y;
+  return false;
+}
+
+void FrameBuffer::ResetCounts()
+{
+  m_Strobes = m_Windows = m_Pixels = 0;
+}
+
+uint32_t FrameBuffer::Checksum() const
+{
+  // FNV-1a over the panel, for regression comparisons
+  uint32_t hash = 2166136261UL;
+  const word* pPixel = &m_Pixel[0][0];
+  for (size_t idx = 0; idx < FB_WIDTH * FB_HEIGHT; idx++, pPixel++)
+  {
+    hash = (hash ^ (*pPixel & 0xFF)) * 16777619UL;
+    hash = (hash ^ (*pPixel >> 8)) * 16777619UL;
+  }
+  return hash;
+}
+
+bool FrameBuffer::SavePPM(const char* fileName) const
+{
+  // write the panel as a binary PPM, expanding RGB565 to 8-bits per channel
+  FILE* pFile = fopen(fileName, "wb");
+  if (!pFile)
+    return false;
+  fprintf(pFile, "P6\n%d %d\n255\n", FB_WIDTH, FB_HEIGHT);
+  for (int y = 0; y < FB_HEIGHT; y++)
+    for (int x = 0; x < FB_WIDTH; x++)
+    {
+      word colour = m_Pixel[y][x];
+      byte rgb[3] = {(byte)((colour >> 8) & 0xF8), (byte)((colour >> 3) & 0xFC), (byte)((colour << 3) & 0xF8)};
+      fwrite(rgb, 1, sizeof(rgb), pFile);
+    }
+  fclose(pFile);
+  return true;
+}
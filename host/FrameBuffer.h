@@ -0,0 +1,55 @@
+#pragma once
+
+// The host's virtual LCD.  An RGB565 frame buffer behind the same interface as the LCD class (LCD.h).
+// Pixels are written into the current window, wrapping, just like the controller's GRAM.
+// Every write the real 8-bit bus would need is counted as a WR strobe:
+//   2 per pixel (16-bit colour over 8 data lines)
+//   the address window set-up, 17 on the HX8347i (Small), 11 on the ILI948x (Large)
+// The simulated clock (see Host.cpp) is advanced by the strobes, so millis() is deterministic.
+
+#ifdef LCD_LARGE
+#define FB_WIDTH  480
+#define FB_HEIGHT 320
+#define FB_WINDOW_STROBES 11
+#else
+#define FB_WIDTH  320
+#define FB_HEIGHT 240
+#define FB_WINDOW_STROBES 17
+#endif
+
+// nominal cost of a WR strobe on a 16MHz Uno, used to advance the simulated clock
+#define FB_NS_PER_STROBE 500
+
+class FrameBuffer
+{
+  public:
+     void init();
+
+     unsigned long beginFill(int x, int y, int w, int h);
+     void fillColour(unsigned long size, word colour);
+     void fillByte(unsigned long size, byte colour);
+     void OneWhite();
+     void OneBlack();
+
+     bool getTouch(int& x, int& y);
+
+     // instrumentation
+     void ResetCounts();
+     uint32_t Checksum() const;
+     bool SavePPM(const char* fileName) const;
+
+     uint32_t m_Strobes = 0;   // simulated WR strobes since ResetCounts()
+     uint32_t m_Windows = 0;   // calls to beginFill
+     uint32_t m_Pixels = 0;    // pixels sent
+
+     word m_Pixel[FB_HEIGHT][FB_WIDTH];
+
+  private:
+     void Put(word colour);
+     void Strobe(uint32_t count);
+
+     int m_X = 0, m_Y = 0, m_W = 0, m_H = 0;  // window
+     unsigned long m_Cursor = 0;             // offset of next pixel in window
+};
+
+extern FrameBuffer fb;
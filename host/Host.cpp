@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <time.h>
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "Elite.h"
+#include "Text.h"
+#include "Ship.h"
+#include "Sparse.h"
+#include "Loader.h"
+#include "Config.h"
+#include "View.h"
+#include "FrameBuffer.h"
+
+// Host runner.  Runs the sketch's setup() and its timed startup, then a number of loop()s, one frame each,
+// reporting the simulated bus traffic per frame:
+//   elitepetite [-f frames] [-s ship] [-o final.ppm] [-q]
+// Output is one line per frame: frame, WR strobes, windows, pixels, simulated ms, frame buffer checksum, sparse pool bytes moved
+// The summary includes the workstation's CPU time per frame, a rough guide to the cost of the non-LCD work
+
+extern void setup();
+extern void loop();
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+
+// The simulated clock
+static uint64_t hostNS = 0;
+
+void hostAdvanceNS(uint64_t ns)
+{
+  hostNS += ns;
+}
+
+unsigned long micros()
+{
+  hostNS += 1000;
+  return hostNS / 1000ULL;
+}
+
+unsigned long millis()
+{
+  hostNS += 1000;
+  return hostNS / 1000000ULL;
+}
+
+void delay(unsigned long ms)
+{
+  hostNS += ms * 1000000ULL;
+}
+
+// Pins, nothing connected; buttons read as open
+void pinMode(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+void digitalWrite(uint8_t, uint8_t) {}
+
+// The avr-libc random(), "minimal standard" Park-Miller, so sequences match the Uno
+static long randomState = 1;
+
+static long NextRandom()
+{
+  long x = randomState;
+  if (x == 0)
+    x = 123459876L;
+  long hi = x / 127773L;
+  long lo = x % 127773L;
+  x = 16807L * lo - 2836L * hi;
+  if (x < 0)
+    x += 0x7FFFFFFFL;
+  randomState = x;
+  return x;
+}
+
+long random(long howBig)
+{
+  if (howBig == 0)
+    return 0;
+  return NextRandom() % howBig;
+}
+
+long random(long howSmall, long howBig)
+{
+  if (howSmall >= howBig)
+    return howSmall;
+  return random(howBig - howSmall) + howSmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+  if (seed != 0)
+    randomState = (long)(seed & 0x7FFFFFFFUL);
+}
+
+int main(int argc, char* argv[])
+{
+  int frames = 100;
+  const char* pPPM = NULL;
+  bool quiet = false;
+  int shipType = -1;
+  for (int arg = 1; arg < argc; arg++)
+  {
+    if (!strcmp(argv[arg], "-f") && arg + 1 < argc)
+      frames = atoi(argv[++arg]);
+    else if (!strcmp(argv[arg], "-o") && arg + 1 < argc)
+      pPPM = argv[++arg];
+    else if (!strcmp(argv[arg], "-s") && arg + 1 < argc)
+      shipType = atoi(argv[++arg]);
+    else if (!strcmp(argv[arg], "-q"))
+      quiet = true;
+    else
+    {
+      fprintf(stderr, "usage: %s [-f frames] [-s ship] [-o final.ppm] [-q]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  setup();
+  // the startup's timed, run it through
+  while (!elite::Running())
+  {
+    loop();
+    delay(1);
+  }
+  if (0 <= shipType && shipType <= ship::LAST_SHIP)
+  {
+    config::data.m_ShipType = static_cast<ship::Type>(shipType);
+    view::LoadShip(true, false);
+  }
+  printf("setup strobes:%lu windows:%lu pixels:%lu ms:%lu\n", (unsigned long)fb.m_Strobes, (unsigned long)fb.m_Windows, (unsigned long)fb.m_Pixels, millis());
+
+  uint64_t sumStrobes = 0, sumWindows = 0, sumPixels = 0, sumMoved = 0;
+  clock_t startClock = clock();
+  for (int frame = 0; frame < frames; frame++)
+  {
+    fb.ResetCounts();
+    sparse::movedBytes = 0;
+    unsigned long startMS = millis();
+    loop();
+    sumStrobes += fb.m_Strobes;
+    sumWindows += fb.m_Windows;
+    sumPixels  += fb.m_Pixels;
+    sumMoved   += sparse::movedBytes;
+    if (!quiet)
+      printf("%d %lu %lu %lu %lu %08lx %lu\n", frame, (unsigned long)fb.m_Strobes, (unsigned long)fb.m_Windows, (unsigned long)fb.m_Pixels, millis() - startMS, (unsigned long)fb.Checksum(),
+             (unsigned long)sparse::movedBytes);
+  }
+  if (frames)
+    printf("average strobes:%lu windows:%lu pixels:%lu moved:%lu host-us:%lu\n", (unsigned long)(sumStrobes / frames), (unsigned long)(sumWindows / frames), (unsigned long)(sumPixels / frames),
+           (unsigned long)(sumMoved / frames), (unsigned long)((clock() - startClock) * 1000000ULL / CLOCKS_PER_SEC / frames));
+  printf("final checksum:%08lx\n", (unsigned long)fb.Checksum());
+
+  if (pPPM && !fb.SavePPM(pPPM))
+  {
+    fprintf(stderr, "can't write %s\n", pPPM);
+    return 1;
+  }
+  return 0;
+}
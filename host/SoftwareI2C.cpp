@@ -0,0 +1,85 @@
+#include <Arduino.h>
+#include "SoftwareI2C.h"
+
+// A DS3231 register file computed on demand: 0=seconds, 1=minutes, 2=hours (24-hour), all BCD
+
+// nominal cost of a byte on the bit-banged bus
+#define I2C_NS_PER_BYTE 100000UL
+
+static uint8_t ToBCD(unsigned long dec)
+{
+  return (dec / 10 * 16) + (dec % 10);
+}
+
+static unsigned long FromBCD(uint8_t bcd)
+{
+  return (bcd / 16 * 10) + (bcd & 0x0F);
+}
+
+void SoftwareI2C::begin(int sda, int scl)
+{
+  (void)sda;
+  (void)scl;
+  m_BaseMS = millis();
+}
+
+void SoftwareI2C::beginTransmission(uint8_t addr)
+{
+  (void)addr;
+  m_Addressed = false;
+  m_Transactions++;
+  hostAdvanceNS(I2C_NS_PER_BYTE);
+}
+
+uint8_t SoftwareI2C::endTransmission()
+{
+  return 0;
+}
+
+size_t SoftwareI2C::write(uint8_t data)
+{
+  hostAdvanceNS(I2C_NS_PER_BYTE);
+  if (!m_Addressed)
+  {
+    // first byte is the register pointer
+    m_Register = data;
+    m_Addressed = true;
+    return 1;
+  }
+  // setting the time, re-base the clock
+  unsigned long now = (m_BaseSeconds + (millis() - m_BaseMS) / 1000) % 86400UL;
+  unsigned long hour = now / 3600, minute = (now / 60) % 60, second = now % 60;
+  if (m_Register == 0)
+    second = FromBCD(data);
+  else if (m_Register == 1)
+    minute = FromBCD(data);
+  else if (m_Register == 2)
+    hour = FromBCD(data & 0x3F);
+  m_BaseSeconds = hour * 3600 + minute * 60 + second;
+  m_BaseMS = millis();
+  m_Register++;
+  return 1;
+}
+
+uint8_t SoftwareI2C::requestFrom(uint8_t addr, uint8_t quantity)
+{
+  (void)addr;
+  m_Transactions++;
+  hostAdvanceNS(I2C_NS_PER_BYTE);
+  return quantity;
+}
+
+uint8_t SoftwareI2C::read()
+{
+  hostAdvanceNS(I2C_NS_PER_BYTE);
+  unsigned long now = (m_BaseSeconds + (millis() - m_BaseMS) / 1000) % 86400UL;
+  uint8_t value = 0;
+  if (m_Register == 0)
+    value = ToBCD(now % 60);
+  else if (m_Register == 1)
+    value = ToBCD((now / 60) % 60);
+  else if (m_Register == 2)
+    value = ToBCD(now / 3600);
+  m_Register++;
+  return value;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Host stand-in for the SoftwareI2C library with a simulated DS3231 on the bus.
+// The clock starts at HOST_RTC_START (seconds after midnight) and runs off the simulated millis()
+#ifndef HOST_RTC_START
+#define HOST_RTC_START (10*3600UL + 8*60UL)  // 10:08:00
+#endif
+
+class SoftwareI2C
+{
+  public:
+    void begin(int sda, int scl);
+    void beginTransmission(uint8_t addr);
+    uint8_t endTransmission();
+    size_t write(uint8_t data);
+    uint8_t requestFrom(uint8_t addr, uint8_t quantity);
+    uint8_t read();
+
+    uint32_t m_Transactions = 0;  // bus transactions, for profiling
+
+  private:
+    uint8_t m_Register = 0;
+    bool m_Addressed = false;
+    unsigned long m_BaseSeconds = HOST_RTC_START;
+    unsigned long m_BaseMS = 0;
+};